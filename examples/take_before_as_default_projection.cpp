@@ -3,6 +3,7 @@
 // This example demonstrates the usage of beman::take_before in a range-printer.
 // Requires: range support (C++20).
 
+#include <beman/take_before/format.hpp>
 #include <beman/take_before/take_before.hpp>
 
 #include <algorithm>
@@ -18,11 +19,8 @@ int main() {
 
     std::cout << "Full string: " << text << '\n';
 
-    std::cout << "Take before '!': ";
-    for (char c : text | btb::views::take_before('!')) {
-        std::cout << c;
-    }
-    std::cout << '\n';
+    // Inserted as one string rather than character by character.
+    std::cout << "Take before '!': " << (text | btb::views::take_before('!')) << '\n';
 
     return 0;
 }
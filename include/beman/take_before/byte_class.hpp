@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_BYTE_CLASS_HPP
+#define BEMAN_TAKE_BEFORE_BYTE_CLASS_HPP
+
+#include <beman/take_before/detail/find.hpp>
+#include <beman/take_before/detail/swar.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string_view>
+
+namespace beman::take_before {
+
+// ============================================================================
+// byte_class
+// ============================================================================
+
+// A set of byte values, usable as the delimiter of views::take_before and
+// the other algorithms taking one: a byte element "equals" a byte_class when
+// it is a member. That == is a membership test, not an equality, so
+// byte_class is a membership delimiter (see detail::indirect_delimiter) and
+// has no == between classes; same_members() compares two of them. A class
+// of one byte is constructed explicitly, so a byte never turns into a class
+// behind a comparison.
+//
+// Membership is a bit test in a 256-bit table, so the cost per byte does not
+// depend on the size of the class. Bounded contiguous ranges are searched
+// with memchr for a class of one byte, with eight-byte word tests for up to
+// four, and with the table otherwise. Null-terminated input from an iterator
+// is searched with strcspn.
+class byte_class {
+    std::uint64_t bits_[4] = {};
+
+  public:
+    constexpr byte_class() noexcept = default;
+
+    template <class B>
+        requires detail::byte_element<B>
+    constexpr explicit byte_class(B b) noexcept {
+        add(detail::to_byte(b));
+    }
+
+    constexpr byte_class(std::initializer_list<unsigned char> members) noexcept {
+        for (unsigned char b : members) {
+            add(b);
+        }
+    }
+
+    constexpr explicit byte_class(std::string_view members) noexcept {
+        for (char c : members) {
+            add(static_cast<unsigned char>(c));
+        }
+    }
+
+    // The bytes lo through hi.
+    static constexpr byte_class range(unsigned char lo, unsigned char hi) noexcept {
+        byte_class c;
+        for (unsigned b = lo; b <= hi; ++b) {
+            c.add(static_cast<unsigned char>(b));
+        }
+        return c;
+    }
+
+    constexpr bool contains(unsigned char b) const noexcept { return (bits_[b >> 6] >> (b & 63)) & 1; }
+    constexpr bool operator[](unsigned char b) const noexcept { return contains(b); }
+
+    constexpr std::size_t size() const noexcept {
+        std::size_t n = 0;
+        for (std::uint64_t w : bits_) {
+            n += static_cast<std::size_t>(std::popcount(w));
+        }
+        return n;
+    }
+
+    constexpr byte_class operator~() const noexcept {
+        byte_class c;
+        for (int k = 0; k < 4; ++k) {
+            c.bits_[k] = ~bits_[k];
+        }
+        return c;
+    }
+
+    friend constexpr byte_class operator|(const byte_class& x, const byte_class& y) noexcept {
+        byte_class c;
+        for (int k = 0; k < 4; ++k) {
+            c.bits_[k] = x.bits_[k] | y.bits_[k];
+        }
+        return c;
+    }
+
+    friend constexpr byte_class operator&(const byte_class& x, const byte_class& y) noexcept {
+        byte_class c;
+        for (int k = 0; k < 4; ++k) {
+            c.bits_[k] = x.bits_[k] & y.bits_[k];
+        }
+        return c;
+    }
+
+    constexpr bool same_members(const byte_class& other) const noexcept {
+        for (int k = 0; k < 4; ++k) {
+            if (bits_[k] != other.bits_[k]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <class B>
+        requires detail::byte_element<B>
+    friend constexpr bool operator==(const byte_class& x, B b) noexcept {
+        return x.contains(detail::to_byte(b));
+    }
+
+    template <class B>
+        requires detail::byte_element<B>
+    friend const B* find_delimiter_n(const byte_class& c, const B* first, std::size_t n) {
+        std::array<unsigned char, 4> members{};
+        const std::size_t            count = c.members(members.data(), members.size());
+        if (count == 0) {
+            return first + n;
+        }
+        const auto* p = reinterpret_cast<const unsigned char*>(first);
+        return first + detail::find_any_byte(p, 0, n, members.data(), count, c);
+    }
+
+    template <class B>
+        requires detail::byte_element<B>
+    friend const B* find_delimiter(const byte_class& c, const B* first) {
+        // strcspn stops at the first member or NUL; a NUL outside the class
+        // does not end the search, which continues past it with the table.
+        unsigned char     members[256];
+        const std::size_t count = (c & ~byte_class('\0')).members(members, sizeof(members));
+        members[count]          = '\0';
+
+        const auto* p = reinterpret_cast<const unsigned char*>(first);
+        std::size_t i = std::strcspn(reinterpret_cast<const char*>(p), reinterpret_cast<const char*>(members));
+        while (!c.contains(p[i])) {
+            ++i;
+        }
+        return first + i;
+    }
+
+  private:
+    constexpr void add(unsigned char b) noexcept { bits_[b >> 6] |= std::uint64_t(1) << (b & 63); }
+
+    // Writes the first max members in increasing order; returns how many
+    // members there are in all.
+    std::size_t members(unsigned char* out, std::size_t max) const noexcept {
+        std::size_t n = 0;
+        for (int k = 0; k < 4; ++k) {
+            for (std::uint64_t w = bits_[k]; w != 0; w &= w - 1, ++n) {
+                if (n < max) {
+                    out[n] = static_cast<unsigned char>(k * 64 + std::countr_zero(w));
+                }
+            }
+        }
+        return n;
+    }
+};
+
+template <>
+inline constexpr bool detail::is_membership_delimiter<byte_class> = true;
+
+} // namespace beman::take_before
+
+#endif // BEMAN_TAKE_BEFORE_BYTE_CLASS_HPP
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_C_STR_VIEW_HPP
+#define BEMAN_TAKE_BEFORE_C_STR_VIEW_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace beman::take_before {
+
+// ============================================================================
+// basic_c_str_view class template
+// ============================================================================
+
+// A non-owning view of a null-terminated string that computes its length at
+// most once.
+//
+// Iteration needs no length: end() returns a sentinel that compares equal to
+// the terminator, exactly as views::take_before(p, CharT()) does. The first
+// call to size() (or to the conversion to basic_string_view) runs
+// Traits::length and caches the result; afterwards the sentinel compares
+// pointers and every size query is O(1). The view is contiguous and sized,
+// and c_str() always returns a null-terminated string for C APIs.
+//
+// The length cache is updated from const member functions through a
+// relaxed atomic, so, as for any standard library type, const member
+// functions may be called concurrently on the same object. Threads that race
+// to fill the cache compute and store the same length.
+template <class CharT, class Traits = std::char_traits<CharT>>
+class basic_c_str_view : public std::ranges::view_interface<basic_c_str_view<CharT, Traits>> {
+  public:
+    using traits_type     = Traits;
+    using value_type      = CharT;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer         = CharT*;
+    using const_pointer   = const CharT*;
+    using reference       = CharT&;
+    using const_reference = const CharT&;
+    using const_iterator  = const CharT*;
+    using iterator        = const_iterator;
+
+    static constexpr size_type npos = size_type(-1);
+
+    class sentinel {
+        const CharT* end_ = nullptr; // null while the length is unknown
+
+        friend class basic_c_str_view;
+
+        constexpr explicit sentinel(const CharT* end) : end_(end) {}
+
+      public:
+        sentinel() = default;
+
+        friend constexpr bool operator==(const CharT* x, const sentinel& y) {
+            return y.end_ ? x == y.end_ : Traits::eq(*x, CharT());
+        }
+    };
+
+  private:
+    static constexpr CharT empty_[1] = {};
+
+    const CharT* str_ = empty_;
+    alignas(std::atomic_ref<size_type>::required_alignment) mutable size_type size_ = 0;
+
+    constexpr size_type cached_size() const noexcept {
+        if (std::is_constant_evaluated()) {
+            return size_;
+        }
+        return std::atomic_ref<size_type>(size_).load(std::memory_order_relaxed);
+    }
+
+  public:
+    constexpr basic_c_str_view() noexcept = default;
+
+    // Preconditions: str points to a null-terminated string.
+    constexpr basic_c_str_view(const CharT* str) noexcept : str_(str), size_(npos) {}
+
+    // Preconditions: Traits::eq(str[size], CharT()) and no earlier element
+    // of [str, str + size) is the terminator.
+    constexpr basic_c_str_view(const CharT* str, size_type size) noexcept : str_(str), size_(size) {}
+
+    template <class Allocator>
+    constexpr basic_c_str_view(const std::basic_string<CharT, Traits, Allocator>& str) noexcept
+        : str_(str.c_str()), size_(str.size()) {}
+
+    basic_c_str_view(std::nullptr_t) = delete;
+
+    // Copies read the source's cache atomically, as size() may be filling it.
+    constexpr basic_c_str_view(const basic_c_str_view& other) noexcept
+        : str_(other.str_), size_(other.cached_size()) {}
+
+    constexpr basic_c_str_view& operator=(const basic_c_str_view& other) noexcept {
+        str_  = other.str_;
+        size_ = other.cached_size();
+        return *this;
+    }
+
+    constexpr const CharT* c_str() const noexcept { return str_; }
+    constexpr const CharT* data() const noexcept { return str_; }
+
+    constexpr const_iterator begin() const noexcept { return str_; }
+
+    constexpr sentinel end() const noexcept {
+        const size_type n = cached_size();
+        return sentinel(n == npos ? nullptr : str_ + n);
+    }
+
+    constexpr bool empty() const noexcept { return Traits::eq(*str_, CharT()); }
+
+    // Whether the length has already been computed; size() is O(1) if so.
+    constexpr bool size_known() const noexcept { return cached_size() != npos; }
+
+    constexpr size_type size() const noexcept {
+        size_type n = cached_size();
+        if (n == npos) {
+            n = Traits::length(str_);
+            if (std::is_constant_evaluated()) {
+                size_ = n;
+            } else {
+                std::atomic_ref<size_type>(size_).store(n, std::memory_order_relaxed);
+            }
+        }
+        return n;
+    }
+    constexpr size_type length() const noexcept { return size(); }
+
+    constexpr std::basic_string_view<CharT, Traits> view() const noexcept {
+        return std::basic_string_view<CharT, Traits>(str_, size());
+    }
+
+    constexpr operator std::basic_string_view<CharT, Traits>() const noexcept { return view(); }
+};
+
+using c_str_view    = basic_c_str_view<char>;
+using wc_str_view   = basic_c_str_view<wchar_t>;
+using u8c_str_view  = basic_c_str_view<char8_t>;
+using u16c_str_view = basic_c_str_view<char16_t>;
+using u32c_str_view = basic_c_str_view<char32_t>;
+
+} // namespace beman::take_before
+
+// ============================================================================
+// enable_borrowed_range specialization
+// ============================================================================
+
+namespace std::ranges {
+template <class CharT, class Traits>
+constexpr bool enable_borrowed_range<beman::take_before::basic_c_str_view<CharT, Traits>> = true;
+} // namespace std::ranges
+
+#endif // BEMAN_TAKE_BEFORE_C_STR_VIEW_HPP
@@ -0,0 +1,221 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_COMPARE_HPP
+#define BEMAN_TAKE_BEFORE_COMPARE_HPP
+
+#include <beman/take_before/detail/find.hpp>
+#include <beman/take_before/take_before.hpp>
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace beman::take_before {
+
+namespace detail {
+
+// A take_before_view of CharT that can be iterated through a const reference.
+template <class R>
+concept const_character_view =
+    std::ranges::input_range<const R> && character<std::remove_cv_t<std::ranges::range_value_t<const R>>>;
+
+template <class R>
+using view_char_t = std::remove_cv_t<std::ranges::range_value_t<const R>>;
+
+// A take_before_view whose base is contiguous and either sized or unbounded,
+// so that its prefix can be scanned with the C library.
+template <class V, class T>
+concept contiguous_character_view =
+    const_character_view<take_before_view<V, T>> && std::ranges::contiguous_range<const V> &&
+    (std::ranges::sized_range<const V> || std::same_as<std::ranges::sentinel_t<const V>, std::unreachable_sentinel_t>);
+
+// Elements per round of the contiguous comparison: one delimiter search per
+// side, then one memcmp of what both sides have in common.
+inline constexpr std::size_t compare_block = 256;
+
+// One side of a comparison laid out in memory: bound elements are readable
+// (npos if the side is an unbounded take_before prefix) and, for views, the
+// side ends early at the first element equal to *value.
+template <class CharT, class T>
+struct contiguous_side {
+    const CharT* data;
+    std::size_t  bound;
+    const T*     value;
+
+    std::size_t before(std::size_t i, std::size_t k) const {
+        if (value == nullptr) {
+            return k;
+        }
+        if constexpr ((byte_element<CharT> || wide_element<CharT>) && kernel_value<CharT, T>) {
+            return static_cast<std::size_t>(find_value_n(data + i, k, *value) - (data + i));
+        } else {
+            return static_cast<std::size_t>(find_value_scalar(data + i, data + i + k, *value) - (data + i));
+        }
+    }
+};
+
+// strcmp over two sides, a block at a time, stopping at the first
+// difference or at the end of the shorter side. For an unbounded side the
+// delimiter search stops at the delimiter, and memcmp only reads elements
+// before it.
+template <class CharT, class TA, class TB>
+int compare_contiguous(const contiguous_side<CharT, TA>& a, const contiguous_side<CharT, TB>& b) {
+    for (std::size_t i = 0;;) {
+        const std::size_t ka = std::min(compare_block, a.bound - i);
+        const std::size_t kb = std::min(compare_block, b.bound - i);
+        const std::size_t sa = a.before(i, ka);
+        const std::size_t sb = b.before(i, kb);
+        const std::size_t m  = std::min(sa, sb);
+        if (const int c = std::char_traits<CharT>::compare(a.data + i, b.data + i, m)) {
+            return c;
+        }
+        const bool a_ends = sa < ka || i + ka == a.bound;
+        const bool b_ends = sb < kb || i + kb == b.bound;
+        if ((a_ends && sa == m) || (b_ends && sb == m)) {
+            // One side is exhausted at i + m; the other may still have an
+            // element there, possibly just past its block.
+            const auto more = [&](const auto& side, std::size_t s, bool ends) {
+                return s > m || (!ends && side.before(i + m, 1) == 1);
+            };
+            const bool a_more = more(a, sa, a_ends);
+            const bool b_more = more(b, sb, b_ends);
+            return a_more == b_more ? 0 : a_more ? 1 : -1;
+        }
+        i += m;
+    }
+}
+
+// The same comparison through iterators, for other bases and for constant
+// evaluation.
+template <class CharT, class I1, class S1, class I2, class S2>
+constexpr int compare_iterators(I1 f1, const S1& l1, I2 f2, const S2& l2) {
+    using traits = std::char_traits<CharT>;
+    for (;; ++f1, ++f2) {
+        const bool e1 = f1 == l1;
+        const bool e2 = f2 == l2;
+        if (e1 || e2) {
+            return e1 ? (e2 ? 0 : -1) : 1;
+        }
+        const CharT c1 = *f1;
+        const CharT c2 = *f2;
+        if (!traits::eq(c1, c2)) {
+            return traits::lt(c1, c2) ? -1 : 1;
+        }
+    }
+}
+
+template <class CharT, class Traits>
+auto as_side(std::basic_string_view<CharT, Traits> s) {
+    return contiguous_side<CharT, CharT>{s.data(), s.size(), nullptr};
+}
+
+template <class V, class T, class CharT = view_char_t<take_before_view<V, T>>>
+auto as_side(const take_before_view<V, T>& v, const T& value) {
+    const auto& base = view_access::base(v);
+    std::size_t bound = std::size_t(-1);
+    if constexpr (std::ranges::sized_range<const V>) {
+        bound = static_cast<std::size_t>(std::ranges::size(base));
+    }
+    return contiguous_side<CharT, T>{std::to_address(std::ranges::begin(base)), bound, std::addressof(value)};
+}
+
+template <class CharT, class Traits, class V, class T>
+constexpr int compare(const take_before_view<V, T>& v, std::basic_string_view<CharT, Traits> s) {
+    if constexpr (contiguous_character_view<V, T>) {
+        if (!std::is_constant_evaluated()) {
+            const auto& value = view_access::value(v);
+            return compare_contiguous(as_side(v, value), as_side(s));
+        }
+    }
+    return compare_iterators<CharT>(v.begin(), v.end(), s.begin(), s.end());
+}
+
+template <class V1, class T1, class V2, class T2>
+constexpr int compare(const take_before_view<V1, T1>& a, const take_before_view<V2, T2>& b) {
+    if constexpr (contiguous_character_view<V1, T1> &&
+                  contiguous_character_view<V2, T2>) {
+        if (!std::is_constant_evaluated()) {
+            const auto& va = view_access::value(a);
+            const auto& vb = view_access::value(b);
+            return compare_contiguous(as_side(a, va), as_side(b, vb));
+        }
+    }
+    return compare_iterators<view_char_t<take_before_view<V1, T1>>>(a.begin(), a.end(), b.begin(), b.end());
+}
+
+// view == string: only the first size() + 1 elements of the view can matter,
+// so the delimiter search is bounded by the string's length.
+template <class CharT, class Traits, class V, class T>
+constexpr bool equal(const take_before_view<V, T>& v, std::basic_string_view<CharT, Traits> s) {
+    if constexpr (contiguous_character_view<V, T>) {
+        if (!std::is_constant_evaluated()) {
+            const auto& value = view_access::value(v);
+            const auto  side  = as_side(v, value);
+            if (side.bound < s.size()) {
+                return false;
+            }
+            const std::size_t k = std::min(side.bound, s.size() + 1);
+            return side.before(0, k) == s.size() && Traits::compare(side.data, s.data(), s.size()) == 0;
+        }
+    }
+    return compare_iterators<CharT>(v.begin(), v.end(), s.begin(), s.end()) == 0;
+}
+
+template <class V, class T, class S>
+concept comparable_string =
+    const_character_view<take_before_view<V, T>> &&
+    std::convertible_to<const S&, std::basic_string_view<view_char_t<take_before_view<V, T>>>>;
+
+template <class V1, class T1, class V2, class T2>
+concept comparable_views =
+    const_character_view<take_before_view<V1, T1>> && const_character_view<take_before_view<V2, T2>> &&
+    std::same_as<view_char_t<take_before_view<V1, T1>>, view_char_t<take_before_view<V2, T2>>>;
+
+} // namespace detail
+
+// ============================================================================
+// Comparison operators
+// ============================================================================
+
+// Character take_before_views compare like the strings they spell, with
+// strcmp/string_view semantics: against anything convertible to
+// basic_string_view (std::string, literals, string_view; on either side) and
+// against each other. Each comparison is one pass that stops at the first
+// difference or delimiter. When the bases are contiguous it runs in blocks,
+// each a memchr per view and one memcmp, so neither side is measured to its
+// end first; other bases are walked element by element.
+
+template <class V, class T, class S>
+    requires detail::comparable_string<V, T, S>
+constexpr bool operator==(const take_before_view<V, T>& v, const S& s) {
+    return detail::equal(v, std::basic_string_view<detail::view_char_t<take_before_view<V, T>>>(s));
+}
+
+template <class V, class T, class S>
+    requires detail::comparable_string<V, T, S>
+constexpr std::strong_ordering operator<=>(const take_before_view<V, T>& v, const S& s) {
+    return detail::compare(v, std::basic_string_view<detail::view_char_t<take_before_view<V, T>>>(s)) <=> 0;
+}
+
+template <class V1, class T1, class V2, class T2>
+    requires detail::comparable_views<V1, T1, V2, T2>
+constexpr bool operator==(const take_before_view<V1, T1>& a, const take_before_view<V2, T2>& b) {
+    return detail::compare(a, b) == 0;
+}
+
+template <class V1, class T1, class V2, class T2>
+    requires detail::comparable_views<V1, T1, V2, T2>
+constexpr std::strong_ordering operator<=>(const take_before_view<V1, T1>& a, const take_before_view<V2, T2>& b) {
+    return detail::compare(a, b) <=> 0;
+}
+
+} // namespace beman::take_before
+
+#endif // BEMAN_TAKE_BEFORE_COMPARE_HPP
@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_COPY_BEFORE_HPP
+#define BEMAN_TAKE_BEFORE_COPY_BEFORE_HPP
+
+#include <beman/take_before/detail/find.hpp>
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace beman::take_before {
+
+// ============================================================================
+// copy_before algorithm
+// ============================================================================
+
+enum class copy_before_status {
+    found,     // stopped at the delimiter; in points at it
+    exhausted, // the input ended without a delimiter
+    truncated, // the output filled up first; in points at the first element not copied
+};
+
+// Converts like std::ranges::in_out_result, so the range overloads can
+// return std::ranges::dangling for an rvalue range that does not borrow.
+template <class I, class O>
+struct copy_before_result {
+    [[no_unique_address]] I in;
+    [[no_unique_address]] O out;
+    copy_before_status      status;
+
+    template <class I2, class O2>
+        requires std::convertible_to<const I&, I2> && std::convertible_to<const O&, O2>
+    constexpr operator copy_before_result<I2, O2>() const& {
+        return {in, out, status};
+    }
+
+    template <class I2, class O2>
+        requires std::convertible_to<I, I2> && std::convertible_to<O, O2>
+    constexpr operator copy_before_result<I2, O2>() && {
+        return {std::move(in), std::move(out), status};
+    }
+};
+
+namespace detail {
+
+// Elements per memchr/memcpy round of the contiguous path: large enough to
+// amortize the calls, small enough that the copy reads what the search has
+// just brought into cache.
+inline constexpr std::ptrdiff_t copy_before_block = 1024;
+
+template <class I, class S, class O, class OS, class T>
+concept copy_before_kernel_applicable =
+    std::contiguous_iterator<I> && std::contiguous_iterator<O> &&
+    (std::sized_sentinel_for<S, I> || std::same_as<S, std::unreachable_sentinel_t>) &&
+    std::sized_sentinel_for<OS, O> && std::same_as<std::remove_cv_t<std::iter_value_t<I>>, std::iter_value_t<O>> &&
+    (byte_element<std::iter_value_t<O>> || wide_element<std::iter_value_t<O>>) &&
+    kernel_value<std::iter_value_t<O>, T>;
+
+// The same loop as the scalar path, one block at a time: the delimiter
+// search and the copy each run as one library call per block.
+template <class I, class S, class O, class OS, class T>
+copy_before_result<I, O> copy_before_blocks(I first, const S& last, O result, const OS& result_last, const T& value) {
+    using E = std::iter_value_t<O>;
+
+    constexpr bool bounded = !std::same_as<S, std::unreachable_sentinel_t>;
+
+    const E* const       in   = std::to_address(first);
+    E* const             out  = std::to_address(result);
+    const std::ptrdiff_t room = result_last - result;
+    std::ptrdiff_t       size = room;
+    if constexpr (bounded) {
+        size = last - first;
+    }
+
+    std::ptrdiff_t     n = 0; // elements copied so far
+    copy_before_status status{};
+    for (;;) {
+        if (bounded && n == size) {
+            status = copy_before_status::exhausted;
+            break;
+        }
+        if (n == room) {
+            status = value == in[n] ? copy_before_status::found : copy_before_status::truncated;
+            break;
+        }
+        auto k = std::min(room - n, copy_before_block);
+        if constexpr (bounded) {
+            k = std::min(k, size - n);
+        }
+        // An unbounded input may end inside the block; memchr stops at the
+        // delimiter, which the caller guarantees is there.
+        const auto m = detail::find_value_n(in + n, static_cast<std::size_t>(k), value) - (in + n);
+        std::memcpy(out + n, in + n, static_cast<std::size_t>(m) * sizeof(E));
+        n += m;
+        if (m < k) {
+            status = copy_before_status::found;
+            break;
+        }
+    }
+    return {first + n, result + n, status};
+}
+
+} // namespace detail
+
+struct copy_before_fn {
+    // Copies the elements of [first, last) that precede the first one equal
+    // to value into [result, result_last), searching and copying in a single
+    // pass, with stpncpy/strlcpy-like reporting of where both sides stopped.
+    // No terminator is written. Contiguous inputs of bytes or wchar_t copied
+    // into contiguous outputs of the same type run block by block through
+    // memchr and memcpy.
+    template <std::input_iterator I, std::sentinel_for<I> S, std::input_or_output_iterator O, std::sentinel_for<O> OS,
+              class T>
+        requires std::indirectly_copyable<I, O> && detail::indirect_delimiter<I, T>
+    constexpr copy_before_result<I, O>
+    operator()(I first, S last, const T& value, O result, OS result_last) const {
+        if constexpr (detail::copy_before_kernel_applicable<I, S, O, OS, T>) {
+            if (!std::is_constant_evaluated()) {
+                return detail::copy_before_blocks(std::move(first), last, std::move(result), result_last, value);
+            }
+        }
+        for (;; ++first, ++result) {
+            if (first == last) {
+                return {std::move(first), std::move(result), copy_before_status::exhausted};
+            }
+            if (value == *first) {
+                return {std::move(first), std::move(result), copy_before_status::found};
+            }
+            if (result == result_last) {
+                return {std::move(first), std::move(result), copy_before_status::truncated};
+            }
+            *result = *first;
+        }
+    }
+
+    template <std::ranges::input_range R, class T, std::input_or_output_iterator O, std::sentinel_for<O> OS>
+        requires std::indirectly_copyable<std::ranges::iterator_t<R>, O> &&
+                 detail::indirect_delimiter<std::ranges::iterator_t<R>, T>
+    constexpr copy_before_result<std::ranges::borrowed_iterator_t<R>, O>
+    operator()(R&& r, const T& value, O result, OS result_last) const {
+        return (*this)(std::ranges::begin(r), std::ranges::end(r), value, std::move(result), std::move(result_last));
+    }
+
+    template <std::ranges::input_range R, class T, std::ranges::range OR>
+        requires std::indirectly_copyable<std::ranges::iterator_t<R>, std::ranges::iterator_t<OR>> &&
+                 detail::indirect_delimiter<std::ranges::iterator_t<R>, T>
+    constexpr copy_before_result<std::ranges::borrowed_iterator_t<R>, std::ranges::borrowed_iterator_t<OR>>
+    operator()(R&& r, const T& value, OR&& out) const {
+        return (*this)(std::ranges::begin(r), std::ranges::end(r), value, std::ranges::begin(out),
+                       std::ranges::end(out));
+    }
+
+    // Unbounded input from an iterator, as views::take_before(i, value);
+    // the status is never exhausted.
+    template <class I, class T, std::input_or_output_iterator O, std::sentinel_for<O> OS>
+        requires std::input_iterator<std::decay_t<I>> && (!std::ranges::range<std::remove_cvref_t<I>>) &&
+                 std::indirectly_copyable<std::decay_t<I>, O> &&
+                 detail::indirect_delimiter<std::decay_t<I>, T>
+    constexpr copy_before_result<std::decay_t<I>, O>
+    operator()(I&& i, const T& value, O result, OS result_last) const {
+        return (*this)(std::decay_t<I>(std::forward<I>(i)), std::unreachable_sentinel, value, std::move(result),
+                       std::move(result_last));
+    }
+};
+
+inline constexpr copy_before_fn copy_before;
+
+} // namespace beman::take_before
+
+#endif // BEMAN_TAKE_BEFORE_COPY_BEFORE_HPP
@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_DETAIL_FIND_HPP
+#define BEMAN_TAKE_BEFORE_DETAIL_FIND_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <cwchar>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace beman::take_before::detail {
+
+// ============================================================================
+// Delimiter search kernel
+// ============================================================================
+//
+// find_value(first, last, value) returns the first position in [first, last)
+// whose element compares equal to value, or last if there is none. It has the
+// same observable behavior as walking take_before_view's sentinel, but routes
+// contiguous ranges of bytes and wide characters through the C library's
+// memchr/strchr family, which every mainstream libc implements with vector
+// instructions. Everything else, and every constant evaluation, takes the
+// scalar loop.
+
+// The delimiter requirement of every view and algorithm in the library,
+// which compare value == e for each element e. For an ordinary delimiter it
+// is P3220's std::indirect_binary_predicate over std::ranges::equal_to, so
+// == must be an equality. A delimiter type that stands for a set of values
+// (byte_class) opts out through is_membership_delimiter: its == is a
+// membership test, which is not an equivalence relation, so it only has to
+// be well-formed, through membership_match.
+template <class T>
+inline constexpr bool is_membership_delimiter = false;
+
+struct membership_match {
+    template <class E, class T>
+        requires requires(const E& e, const T& value) {
+            { value == e } -> std::convertible_to<bool>;
+        }
+    constexpr bool operator()(const E& e, const T& value) const {
+        return static_cast<bool>(value == e);
+    }
+};
+
+template <class I, class T>
+concept indirect_delimiter =
+    (!is_membership_delimiter<std::remove_cv_t<T>> &&
+     std::indirect_binary_predicate<std::ranges::equal_to, I, const T*>) ||
+    (is_membership_delimiter<std::remove_cv_t<T>> && std::indirect_binary_predicate<membership_match, I, const T*>);
+
+// Element types the C library search functions can scan.
+template <class E>
+concept byte_element = sizeof(E) == 1 && !std::same_as<E, bool> && (std::integral<E> || std::same_as<E, std::byte>);
+
+template <class E>
+concept wide_element = std::same_as<E, wchar_t>;
+
+// A delimiter of type T can be handed to the vector kernel for elements of
+// type E when `value == e` is an ordinary mathematical comparison, i.e. no
+// usual arithmetic conversion turns a negative element into a large unsigned
+// value.
+template <class E, class T>
+concept kernel_value =
+    std::same_as<std::remove_cv_t<T>, E> ||
+    (std::integral<E> && std::integral<T> && !std::same_as<T, bool> &&
+     !(std::is_signed_v<E> && std::is_unsigned_v<T> && sizeof(T) >= sizeof(int)) &&
+     !(std::is_signed_v<T> && std::is_unsigned_v<E> && sizeof(E) >= sizeof(int)));
+
+// Whether searching for static_cast<E>(value) finds exactly the elements
+// that `value == e` accepts. The test is that same comparison, after the same
+// promotions: round-tripping through E instead would accept a char '\xff'
+// for unsigned char elements, which promote to 255 and never equal -1.
+template <class E, class T>
+constexpr bool representable_as(const T& value) {
+    if constexpr (std::same_as<std::remove_cv_t<T>, E>) {
+        return true;
+    } else {
+        return value == static_cast<E>(value);
+    }
+}
+
+template <class E>
+constexpr unsigned char to_byte(E e) {
+    if constexpr (std::same_as<E, std::byte>) {
+        return std::to_integer<unsigned char>(e);
+    } else {
+        return static_cast<unsigned char>(e);
+    }
+}
+
+template <class I, class S, class T>
+constexpr I find_value_scalar(I first, const S& last, const T& value) {
+    while (!(first == last) && !(value == *first)) {
+        ++first;
+    }
+    return first;
+}
+
+// Searches the n elements starting at first; returns first + n if value is
+// not among them. The C library functions stop at the first match, so n may
+// overstate the readable length as long as a match lies within it.
+template <class E, class T>
+const E* find_value_n(const E* first, std::size_t n, const T& value) {
+    if (n == 0 || !representable_as<E>(value)) {
+        return first + n;
+    }
+    const auto e = static_cast<E>(value);
+    if constexpr (byte_element<E>) {
+        const void* p = std::memchr(first, to_byte(e), n);
+        return p ? static_cast<const E*>(p) : first + n;
+    } else {
+        const wchar_t* p = std::wmemchr(first, e, n);
+        return p ? p : first + n;
+    }
+}
+
+template <class E, class T>
+const E* find_value_bounded(const E* first, const E* last, const T& value) {
+    return find_value_n(first, static_cast<std::size_t>(last - first), value);
+}
+
+// Unbounded search: the caller guarantees that value occurs, exactly as for
+// take_before over an iterator. strchr/wcschr stop at the first NUL, so a
+// non-NUL delimiter that lies beyond one is found by continuing the scalar
+// loop from there.
+template <class E, class T>
+const E* find_value_unbounded(const E* first, const T& value) {
+    if (!representable_as<E>(value)) {
+        return find_value_scalar(first, std::unreachable_sentinel, value);
+    }
+    const auto e = static_cast<E>(value);
+    if constexpr (byte_element<E>) {
+        const auto* s = reinterpret_cast<const char*>(first);
+        const auto  c = to_byte(e);
+        if (c == 0) {
+            return first + std::strlen(s);
+        }
+        if (const char* p = std::strchr(s, c)) {
+            return first + (p - s);
+        }
+        return find_value_scalar(first + std::strlen(s), std::unreachable_sentinel, value);
+    } else {
+        if (e == 0) {
+            return first + std::wcslen(first);
+        }
+        if (const wchar_t* p = std::wcschr(first, e)) {
+            return p;
+        }
+        return find_value_scalar(first + std::wcslen(first), std::unreachable_sentinel, value);
+    }
+}
+
+// Delimiter types that bring their own search over n contiguous elements
+// (ascii_icase_char, traits_char, byte_class): find_delimiter_n(value, first,
+// n), found by argument-dependent lookup, has the contract of find_value_n.
+// They may also provide find_delimiter(value, first) for unbounded input,
+// with the contract of find_value_unbounded.
+template <class T, class E>
+concept searchable_delimiter = requires(const T& value, const E* first, std::size_t n) {
+    { find_delimiter_n(value, first, n) } -> std::same_as<const E*>;
+};
+
+template <class T, class E>
+concept unbounded_searchable_delimiter = requires(const T& value, const E* first) {
+    { find_delimiter(value, first) } -> std::same_as<const E*>;
+};
+
+template <class I, class S, class T>
+constexpr I find_value(I first, S last, const T& value) {
+    if constexpr (std::contiguous_iterator<I>) {
+        using E = std::remove_cv_t<std::iter_value_t<I>>;
+        if constexpr ((byte_element<E> || wide_element<E>) && kernel_value<E, T> &&
+                      (std::sized_sentinel_for<S, I> || std::same_as<S, std::unreachable_sentinel_t>)) {
+            if (!std::is_constant_evaluated()) {
+                const E* p = std::to_address(first);
+                if constexpr (std::same_as<S, std::unreachable_sentinel_t>) {
+                    return first + (find_value_unbounded(p, value) - p);
+                } else {
+                    return first + (find_value_bounded(p, p + (last - first), value) - p);
+                }
+            }
+        } else if constexpr (searchable_delimiter<T, E> && std::sized_sentinel_for<S, I>) {
+            if (!std::is_constant_evaluated()) {
+                const E* p = std::to_address(first);
+                return first + (find_delimiter_n(value, p, static_cast<std::size_t>(last - first)) - p);
+            }
+        } else if constexpr (unbounded_searchable_delimiter<T, E> && std::same_as<S, std::unreachable_sentinel_t>) {
+            if (!std::is_constant_evaluated()) {
+                const E* p = std::to_address(first);
+                return first + (find_delimiter(value, p) - p);
+            }
+        }
+    }
+    return find_value_scalar(std::move(first), last, value);
+}
+
+} // namespace beman::take_before::detail
+
+#endif // BEMAN_TAKE_BEFORE_DETAIL_FIND_HPP
@@ -0,0 +1,229 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_DETAIL_STATEFUL_VIEW_HPP
+#define BEMAN_TAKE_BEFORE_DETAIL_STATEFUL_VIEW_HPP
+
+#include <beman/take_before/take_before.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace beman::take_before::detail {
+
+// ============================================================================
+// stateful_take_before_view class template
+// ============================================================================
+
+// The view, iterator and sentinel of the take_before views whose end depends
+// on state carried from element to element (take_before_unescaped_view,
+// take_before_balanced_view). Derived is the public view, which adds the
+// names of its two values; Scan is the state machine over them:
+//
+//   typename Scan::state             carried by the iterator, which derives
+//                                    from it publicly to expose its accessors
+//   Scan::advance(state&, a, b, e)   the iterator moves past element e
+//   Scan::stops(state, a, b, e)      the view ends before element e
+//   Scan::find(first, last, a, b)    the end of [first, last), for to_span()
+//
+// Because the iterator carries state, the view is at most forward.
+template <class Derived, class Scan, std::ranges::view V, std::move_constructible T>
+    requires std::ranges::input_range<V> && std::is_object_v<T> &&
+             detail::indirect_delimiter<std::ranges::iterator_t<V>, T>
+class stateful_take_before_view : public std::ranges::view_interface<Derived> {
+    template <bool>
+    class iterator;
+    template <bool>
+    class sentinel;
+
+    V              base_ = V();
+    movable_box<T> first_;
+    movable_box<T> second_;
+
+    template <std::ranges::contiguous_range R>
+    static constexpr auto span_of(R& r, const T& a, const T& b) {
+        using E    = std::remove_reference_t<std::ranges::range_reference_t<R>>;
+        auto first = std::ranges::begin(r);
+        auto last  = Scan::find(first, std::ranges::end(r), a, b);
+        return std::span<E>(std::to_address(first), static_cast<std::size_t>(last - first));
+    }
+
+  protected:
+    constexpr const T& first_value() const { return *first_; }
+    constexpr const T& second_value() const { return *second_; }
+
+  public:
+    stateful_take_before_view()
+        requires std::default_initializable<V> && std::default_initializable<T>
+    = default;
+
+    constexpr explicit stateful_take_before_view(V base, T first, T second)
+        : base_(std::move(base)), first_(std::move(first)), second_(std::move(second)) {}
+
+    constexpr V base() const&
+        requires std::copy_constructible<V>
+    {
+        return base_;
+    }
+    constexpr V base() && { return std::move(base_); }
+
+    constexpr auto begin()
+        requires(!simple_view<V>)
+    {
+        return iterator<false>(std::ranges::begin(base_), std::addressof(*first_), std::addressof(*second_));
+    }
+
+    constexpr auto begin() const
+        requires std::ranges::range<const V> &&
+                 detail::indirect_delimiter<std::ranges::iterator_t<const V>, T>
+    {
+        return iterator<true>(std::ranges::begin(base_), std::addressof(*first_), std::addressof(*second_));
+    }
+
+    constexpr auto end()
+        requires(!simple_view<V>)
+    {
+        return sentinel<false>(std::ranges::end(base_));
+    }
+
+    constexpr auto end() const
+        requires std::ranges::range<const V> &&
+                 detail::indirect_delimiter<std::ranges::iterator_t<const V>, T>
+    {
+        return sentinel<true>(std::ranges::end(base_));
+    }
+
+    constexpr auto reserve_hint()
+        requires approximately_sized_range<V>
+    {
+        return detail::reserve_hint(base_);
+    }
+
+    constexpr auto reserve_hint() const
+        requires approximately_sized_range<const V>
+    {
+        return detail::reserve_hint(base_);
+    }
+
+    constexpr auto to_span()
+        requires(!simple_view<V>) && std::ranges::contiguous_range<V>
+    {
+        return span_of(base_, *first_, *second_);
+    }
+
+    constexpr auto to_span() const
+        requires std::ranges::contiguous_range<const V> &&
+                 detail::indirect_delimiter<std::ranges::iterator_t<const V>, T>
+    {
+        return span_of(base_, *first_, *second_);
+    }
+};
+
+template <class Derived, class Scan, std::ranges::view V, std::move_constructible T>
+    requires std::ranges::input_range<V> && std::is_object_v<T> &&
+             detail::indirect_delimiter<std::ranges::iterator_t<V>, T>
+template <bool Const>
+class stateful_take_before_view<Derived, Scan, V, T>::iterator
+    : public stateful_iterator_category<maybe_const<Const, V>>,
+      public Scan::state {
+    using Base  = maybe_const<Const, V>;
+    using state = typename Scan::state;
+
+    std::ranges::iterator_t<Base> current_ = std::ranges::iterator_t<Base>();
+    const T*                      first_   = nullptr;
+    const T*                      second_  = nullptr;
+
+    template <bool>
+    friend class iterator;
+    template <bool>
+    friend class sentinel;
+    friend class stateful_take_before_view;
+
+    constexpr iterator(std::ranges::iterator_t<Base> current, const T* first, const T* second)
+        : current_(std::move(current)), first_(first), second_(second) {}
+
+  public:
+    using iterator_concept =
+        std::conditional_t<std::ranges::forward_range<Base>, std::forward_iterator_tag, std::input_iterator_tag>;
+    using value_type      = std::ranges::range_value_t<Base>;
+    using difference_type = std::ranges::range_difference_t<Base>;
+
+    iterator()
+        requires std::default_initializable<std::ranges::iterator_t<Base>>
+    = default;
+
+    constexpr iterator(iterator<!Const> i)
+        requires Const && std::convertible_to<std::ranges::iterator_t<V>, std::ranges::iterator_t<Base>>
+        : state(static_cast<const state&>(i)), current_(std::move(i.current_)), first_(i.first_), second_(i.second_) {}
+
+    constexpr const std::ranges::iterator_t<Base>& base() const& noexcept { return current_; }
+    constexpr std::ranges::iterator_t<Base>        base() && { return std::move(current_); }
+
+    constexpr decltype(auto) operator*() const { return *current_; }
+
+    constexpr iterator& operator++() {
+        Scan::advance(static_cast<state&>(*this), *first_, *second_, *current_);
+        ++current_;
+        return *this;
+    }
+
+    constexpr void operator++(int)
+        requires(!std::ranges::forward_range<Base>)
+    {
+        ++*this;
+    }
+
+    constexpr iterator operator++(int)
+        requires std::ranges::forward_range<Base>
+    {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    friend constexpr bool operator==(const iterator& x, const iterator& y)
+        requires std::equality_comparable<std::ranges::iterator_t<Base>>
+    {
+        return x.current_ == y.current_;
+    }
+};
+
+template <class Derived, class Scan, std::ranges::view V, std::move_constructible T>
+    requires std::ranges::input_range<V> && std::is_object_v<T> &&
+             detail::indirect_delimiter<std::ranges::iterator_t<V>, T>
+template <bool Const>
+class stateful_take_before_view<Derived, Scan, V, T>::sentinel {
+    using Base = maybe_const<Const, V>;
+
+    std::ranges::sentinel_t<Base> end_ = std::ranges::sentinel_t<Base>();
+
+    friend class stateful_take_before_view;
+
+    constexpr explicit sentinel(std::ranges::sentinel_t<Base> end) : end_(std::move(end)) {}
+
+    constexpr bool equal(const iterator<Const>& x) const {
+        return end_ == x.current_ ||
+               Scan::stops(static_cast<const typename Scan::state&>(x), *x.first_, *x.second_, *x.current_);
+    }
+
+  public:
+    sentinel() = default;
+
+    constexpr sentinel(sentinel<!Const> s)
+        requires Const && std::convertible_to<std::ranges::sentinel_t<V>, std::ranges::sentinel_t<Base>>
+        : end_(std::move(s.end_)) {}
+
+    constexpr std::ranges::sentinel_t<Base> base() const { return end_; }
+
+    friend constexpr bool operator==(const iterator<Const>& x, const sentinel& y) { return y.equal(x); }
+};
+
+} // namespace beman::take_before::detail
+
+#endif // BEMAN_TAKE_BEFORE_DETAIL_STATEFUL_VIEW_HPP
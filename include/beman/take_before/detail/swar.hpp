@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_DETAIL_SWAR_HPP
+#define BEMAN_TAKE_BEFORE_DETAIL_SWAR_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace beman::take_before::detail {
+
+// ============================================================================
+// SWAR (SIMD within a register) helpers
+// ============================================================================
+//
+// Byte-parallel tests on 64-bit words, for the fused algorithms that examine
+// eight bytes per load. Words are loaded little-endian, so byte k of the word
+// is the k-th byte in memory and std::countr_zero(mask) / 8 is its offset.
+
+inline constexpr std::uint64_t swar_ones = 0x0101010101010101ULL;
+inline constexpr std::uint64_t swar_high = 0x8080808080808080ULL;
+
+// A byte of w is zero iff the corresponding high bit of has_zero(w) is set;
+// the lowest set bit is exact, higher ones may be false positives after a
+// true zero byte.
+constexpr std::uint64_t has_zero(std::uint64_t w) { return (w - swar_ones) & ~w & swar_high; }
+
+// Marks the bytes of w equal to b, with the same exactness as has_zero.
+constexpr std::uint64_t has_byte(std::uint64_t w, unsigned char b) { return has_zero(w ^ (swar_ones * b)); }
+
+// Exact forms of has_zero and has_byte, where every set high bit marks a
+// matching byte (one more operation), for counting matches with popcount.
+constexpr std::uint64_t zero_bytes(std::uint64_t w) {
+    constexpr std::uint64_t low7 = ~swar_high;
+    return ~(((w & low7) + low7) | w | low7);
+}
+
+constexpr std::uint64_t byte_mask(std::uint64_t w, unsigned char b) { return zero_bytes(w ^ (swar_ones * b)); }
+
+// Whether all eight bytes of w are ASCII digits.
+constexpr bool all_digits(std::uint64_t w) {
+    return ((w & 0xF0F0F0F0F0F0F0F0ULL) | (((w + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+           0x3333333333333333ULL;
+}
+
+// The value of eight ASCII digits loaded by load_le, most significant digit
+// first in memory: pairs, then quadruples, then the whole word, each step one
+// multiply.
+constexpr std::uint32_t eight_digits(std::uint64_t w) {
+    w -= 0x3030303030303030ULL;
+    w = (w * 10) + (w >> 8);
+    w = (((w & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+         (((w >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >>
+        32;
+    return static_cast<std::uint32_t>(w);
+}
+
+inline std::uint64_t load_le(const unsigned char* p) {
+    std::uint64_t w;
+    std::memcpy(&w, p, sizeof(w));
+    if constexpr (std::endian::native == std::endian::big) {
+        w = ((w & 0x00000000ffffffffULL) << 32) | (w >> 32);
+        w = ((w & 0x0000ffff0000ffffULL) << 16) | ((w >> 16) & 0x0000ffff0000ffffULL);
+        w = ((w & 0x00ff00ff00ff00ffULL) << 8) | ((w >> 8) & 0x00ff00ff00ff00ffULL);
+    }
+    return w;
+}
+
+// The first offset in [i, n) whose byte is a member of a byte set, or n. The
+// set is given as a table indexed by byte (such as a std::array<bool, 256>)
+// and, when it has at most four members, also as a list of them (count is
+// the number of members): one member is searched with memchr, up to four
+// with eight-byte word tests, and larger sets with a table lookup per byte.
+template <class Table>
+std::size_t find_any_byte(const unsigned char* p, std::size_t i, std::size_t n, const unsigned char* bytes,
+                          std::size_t count, const Table& table) {
+    if (count == 1) {
+        const void* q = i < n ? std::memchr(p + i, bytes[0], n - i) : nullptr;
+        return q ? static_cast<std::size_t>(static_cast<const unsigned char*>(q) - p) : n;
+    }
+    if (count <= 4) {
+        for (; i + 8 <= n; i += 8) {
+            const std::uint64_t w = load_le(p + i);
+            std::uint64_t       m = 0;
+            for (std::size_t k = 0; k < count; ++k) {
+                m |= has_byte(w, bytes[k]);
+            }
+            if (m != 0) {
+                return i + static_cast<std::size_t>(std::countr_zero(m) / 8);
+            }
+        }
+    }
+    while (i < n && !table[p[i]]) {
+        ++i;
+    }
+    return i;
+}
+
+// The first offset in [i, n) whose byte equals the lowercase ASCII letter
+// lower in either case, or n. Setting bit 0x20 maps exactly the two cases of
+// a letter onto its lowercase form, so each word costs one OR and one byte
+// compare.
+inline std::size_t find_byte_icase(const unsigned char* p, std::size_t i, std::size_t n, unsigned char lower) {
+    for (; i + 8 <= n; i += 8) {
+        const std::uint64_t m = has_byte(load_le(p + i) | (swar_ones * 0x20), lower);
+        if (m != 0) {
+            return i + static_cast<std::size_t>(std::countr_zero(m) / 8);
+        }
+    }
+    while (i < n && (p[i] | 0x20) != lower) {
+        ++i;
+    }
+    return i;
+}
+
+} // namespace beman::take_before::detail
+
+#endif // BEMAN_TAKE_BEFORE_DETAIL_SWAR_HPP
@@ -0,0 +1,231 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_FD_RECORD_READER_HPP
+#define BEMAN_TAKE_BEFORE_FD_RECORD_READER_HPP
+
+#include <beman/take_before/record_splitter.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <semaphore>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if __has_include(<unistd.h>) && __has_include(<poll.h>)
+#include <poll.h>
+#include <unistd.h>
+#define BEMAN_TAKE_BEFORE_HAS_FD_RECORD_READER 1
+#else
+#define BEMAN_TAKE_BEFORE_HAS_FD_RECORD_READER 0
+#endif
+
+#if BEMAN_TAKE_BEFORE_HAS_FD_RECORD_READER
+
+namespace beman::take_before {
+
+// ============================================================================
+// fd_record_reader
+// ============================================================================
+
+struct fd_reader_options {
+    std::size_t buffer_size = std::size_t(1) << 20;
+    std::size_t buffers     = 2; // at least two, so that reading overlaps scanning
+    std::size_t max_record  = record_splitter::unbounded;
+};
+
+// What a for_each call did, for judging how well I/O overlapped with the
+// scan: waiting is the time the scanning thread spent with no filled
+// buffer, i.e. bound by the reads.
+struct fd_reader_stats {
+    std::uint64_t            bytes   = 0;
+    std::uint64_t            records = 0;
+    std::uint64_t            reads   = 0; // read() calls that returned data
+    std::chrono::nanoseconds elapsed{};
+    std::chrono::nanoseconds waiting{};
+
+    double bytes_per_second() const {
+        const double seconds = std::chrono::duration<double>(elapsed).count();
+        return seconds > 0 ? static_cast<double>(bytes) / seconds : 0.0;
+    }
+};
+
+// Delimited records read from a POSIX file descriptor (a regular file, a
+// pipe, a socket) with read-ahead: a background thread fills a ring of
+// buffers with read() while the calling thread splits the filled ones with
+// record_splitter, so the device keeps working during the scan. Each read()
+// that returns data hands its buffer over at once, so records that arrive on
+// a pipe or socket reach the caller without waiting for a full buffer.
+// Records within a buffer are views into it; those that cross buffers are
+// stitched in the splitter's carry. The descriptor is read from its current
+// offset to end of file and is not closed; it may be non-blocking.
+class fd_record_reader {
+    int               fd_;
+    char              delimiter_;
+    fd_reader_options options_;
+
+  public:
+    explicit fd_record_reader(int fd, char delimiter = '\n', const fd_reader_options& options = {})
+        : fd_(fd), delimiter_(delimiter), options_(options) {
+        if (options_.buffers < 2) {
+            options_.buffers = 2;
+        }
+        if (options_.buffer_size == 0) {
+            options_.buffer_size = 1;
+        }
+    }
+
+    int  fd() const noexcept { return fd_; }
+    char delimiter() const noexcept { return delimiter_; }
+
+    // Calls f with every record, in order, on the calling thread; a record
+    // is valid only during the call. A read error throws std::system_error
+    // after the records read before it have been handed out. If f throws,
+    // the reader thread is stopped before the exception propagates: it waits
+    // for input in poll() on the descriptor and on a pipe of its own, which
+    // is written to wake it, so an idle pipe or socket does not delay the
+    // exception.
+    template <class F>
+        requires std::invocable<F&, std::string_view>
+    fd_reader_stats for_each(F&& f) {
+        using clock = std::chrono::steady_clock;
+
+        const std::size_t n = options_.buffers;
+        struct buffer {
+            std::unique_ptr<char[]> data;
+            std::size_t             size  = 0;
+            bool                    last  = false; // end of file or a read error
+            int                     error = 0;
+        };
+        std::vector<buffer> ring(n);
+        for (auto& b : ring) {
+            b.data = std::make_unique<char[]>(options_.buffer_size);
+        }
+
+        // Buffer k % n holds the k-th read. The reader takes a free buffer,
+        // reads into it and hands it over; the scan hands it back when done,
+        // so the reader runs up to n reads ahead.
+        std::counting_semaphore<> free_buffers(static_cast<std::ptrdiff_t>(n));
+        std::counting_semaphore<> full_buffers(0);
+        std::atomic<bool>         stop = false;
+
+        int wake[2];
+        if (::pipe(wake) != 0) {
+            throw std::system_error(errno, std::generic_category(), "fd_record_reader: pipe");
+        }
+        struct pipe_closer {
+            int (&fds)[2];
+            ~pipe_closer() {
+                ::close(fds[0]);
+                ::close(fds[1]);
+            }
+        } close_wake{wake};
+
+        // Waits until fd_ has input or the scan has stopped; whether to read.
+        // A poll() error, and a negative fd_, which poll() ignores, are left
+        // for read() to report.
+        const auto readable = [&] {
+            if (fd_ < 0) {
+                return true;
+            }
+            ::pollfd fds[2] = {{fd_, POLLIN, 0}, {wake[0], POLLIN, 0}};
+            while (::poll(fds, 2, -1) < 0) {
+                if (errno != EINTR) {
+                    return true;
+                }
+            }
+            return fds[1].revents == 0;
+        };
+
+        const auto read_ahead = [&] {
+            for (std::uint64_t k = 0;; ++k) {
+                free_buffers.acquire();
+                if (stop.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                buffer& b = ring[k % n];
+                b.size    = 0;
+                for (;;) {
+                    if (!readable()) {
+                        return;
+                    }
+                    const auto r = ::read(fd_, b.data.get(), options_.buffer_size);
+                    if (r > 0) {
+                        b.size = static_cast<std::size_t>(r);
+                        break;
+                    }
+                    if (r == 0) {
+                        b.last = true;
+                        break;
+                    }
+                    if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+                        b.last  = true;
+                        b.error = errno;
+                        break;
+                    }
+                }
+                const bool last = b.last;
+                full_buffers.release();
+                if (last) {
+                    return;
+                }
+            }
+        };
+
+        fd_reader_stats stats;
+        const auto      start = clock::now();
+        std::thread     reader(read_ahead);
+        struct joiner {
+            std::thread&               thread;
+            std::counting_semaphore<>& free_buffers;
+            std::atomic<bool>&         stop;
+            int                        wake;
+            ~joiner() {
+                stop.store(true, std::memory_order_relaxed);
+                const char byte = 0;
+                [[maybe_unused]] const auto written = ::write(wake, &byte, 1);
+                free_buffers.release();
+                thread.join();
+            }
+        } join_reader{reader, free_buffers, stop, wake[1]};
+
+        record_splitter splitter(delimiter_, options_.max_record);
+        const auto      deliver = [&](std::string_view record) {
+            ++stats.records;
+            std::invoke(f, record);
+        };
+        for (std::uint64_t k = 0;; ++k) {
+            const auto wait_start = clock::now();
+            full_buffers.acquire();
+            stats.waiting += clock::now() - wait_start;
+
+            const buffer& b = ring[k % n];
+            stats.bytes += b.size;
+            stats.reads += b.size > 0;
+            splitter.feed(std::string_view(b.data.get(), b.size), deliver);
+            if (b.last) {
+                if (b.error != 0) {
+                    throw std::system_error(b.error, std::generic_category(), "fd_record_reader: read");
+                }
+                break;
+            }
+            free_buffers.release();
+        }
+        splitter.finish(deliver);
+        stats.elapsed = clock::now() - start;
+        return stats;
+    }
+};
+
+} // namespace beman::take_before
+
+#endif // BEMAN_TAKE_BEFORE_HAS_FD_RECORD_READER
+
+#endif // BEMAN_TAKE_BEFORE_FD_RECORD_READER_HPP
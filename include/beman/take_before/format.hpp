@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_FORMAT_HPP
+#define BEMAN_TAKE_BEFORE_FORMAT_HPP
+
+#include <beman/take_before/take_before.hpp>
+#include <beman/take_before/to.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <version>
+
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
+
+namespace beman::take_before {
+
+namespace detail {
+
+// A take_before_view whose elements are characters of type CharT and which
+// can be iterated through a const reference.
+template <class R, class CharT>
+concept const_character_range = std::ranges::input_range<const R> && character<CharT> &&
+                                std::same_as<std::remove_cv_t<std::ranges::range_value_t<const R>>, CharT>;
+
+template <class CharT, class Traits>
+void write_chars(std::basic_ostream<CharT, Traits>& os, const CharT* s, std::size_t n) {
+    if (n != 0 && os.rdbuf()->sputn(s, static_cast<std::streamsize>(n)) != static_cast<std::streamsize>(n)) {
+        os.setstate(std::ios_base::badbit);
+    }
+}
+
+} // namespace detail
+
+// ============================================================================
+// Stream insertion
+// ============================================================================
+
+// Inserts the characters before the delimiter as one string. For contiguous
+// bases the end is located once and the characters go out through a single
+// basic_string_view insertion (one sputn, honoring width and fill). Other
+// bases are copied through a local buffer, one sputn per buffer, or are
+// materialized first when a field width has to be applied.
+template <class CharT, class Traits, class V, class T>
+    requires detail::const_character_range<take_before_view<V, T>, CharT>
+std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const take_before_view<V, T>& v) {
+    if constexpr (requires { v.to_span(); }) {
+        auto s = v.to_span();
+        return os << std::basic_string_view<CharT, Traits>(s.data(), s.size());
+    } else {
+        if (os.width() != 0) {
+            return os << beman::take_before::to<std::basic_string<CharT, Traits>>(v);
+        }
+        typename std::basic_ostream<CharT, Traits>::sentry ok(os);
+        if (!ok) {
+            return os;
+        }
+        CharT       buffer[256];
+        std::size_t n = 0;
+        for (CharT c : v) {
+            buffer[n++] = c;
+            if (n == std::size(buffer)) {
+                detail::write_chars(os, buffer, n);
+                n = 0;
+            }
+        }
+        detail::write_chars(os, buffer, n);
+        return os;
+    }
+}
+
+} // namespace beman::take_before
+
+// ============================================================================
+// std::formatter specialization
+// ============================================================================
+
+#if defined(__cpp_lib_format)
+
+namespace std {
+
+// Formats a take_before_view of characters as a string, accepting the same
+// format specification as basic_string_view. Contiguous bases are handed to
+// the string_view formatter directly; other bases are materialized once.
+template <class V, class T, class CharT>
+    requires beman::take_before::detail::const_character_range<beman::take_before::take_before_view<V, T>, CharT>
+struct formatter<beman::take_before::take_before_view<V, T>, CharT> : formatter<basic_string_view<CharT>, CharT> {
+    template <class FormatContext>
+    auto format(const beman::take_before::take_before_view<V, T>& v, FormatContext& ctx) const {
+        using base = formatter<basic_string_view<CharT>, CharT>;
+        if constexpr (requires { v.to_span(); }) {
+            auto s = v.to_span();
+            return base::format(basic_string_view<CharT>(s.data(), s.size()), ctx);
+        } else {
+            const auto str = beman::take_before::to<basic_string<CharT>>(v);
+            return base::format(basic_string_view<CharT>(str), ctx);
+        }
+    }
+};
+
+} // namespace std
+
+#endif
+
+#endif // BEMAN_TAKE_BEFORE_FORMAT_HPP
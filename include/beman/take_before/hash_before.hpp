@@ -0,0 +1,290 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_HASH_BEFORE_HPP
+#define BEMAN_TAKE_BEFORE_HASH_BEFORE_HPP
+
+#include <beman/take_before/compare.hpp>
+#include <beman/take_before/detail/find.hpp>
+#include <beman/take_before/detail/swar.hpp>
+#include <beman/take_before/take_before.hpp>
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace beman::take_before {
+
+namespace detail {
+
+// ============================================================================
+// Streaming 64-bit byte hash
+// ============================================================================
+//
+// Input is consumed as little-endian 64-bit words, each mixed into the state
+// with Murmur3's 64-bit multiply/rotate rounds; the trailing 0-7 bytes and
+// the byte count go through a final avalanche. Because the word boundaries
+// depend only on byte offsets, feeding the same bytes one at a time, a word
+// at a time, or as one block yields the same value, which is what lets a
+// take_before prefix hash equal the hash of the std::string it matches.
+class byte_hasher {
+    static constexpr std::uint64_t k1 = 0x87c37b91114253d5ULL;
+    static constexpr std::uint64_t k2 = 0x4cf5ad432745937fULL;
+
+    std::uint64_t h_;
+    std::uint64_t tail_  = 0;
+    unsigned      shift_ = 0; // bits already in tail_
+    std::uint64_t count_ = 0;
+
+    static constexpr std::uint64_t fmix(std::uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    constexpr void mix(std::uint64_t w) {
+        w *= k1;
+        w = std::rotl(w, 31);
+        w *= k2;
+        h_ ^= w;
+        h_ = std::rotl(h_, 27) * 5 + 0x52dce729;
+    }
+
+  public:
+    constexpr explicit byte_hasher(std::uint64_t seed = 0) : h_(seed ^ 0x9e3779b97f4a7c15ULL) {}
+
+    // Precondition: no partial word is pending (aligned()).
+    constexpr void word(std::uint64_t w) {
+        mix(w);
+        count_ += 8;
+    }
+
+    constexpr void byte(unsigned char b) {
+        tail_ |= std::uint64_t(b) << shift_;
+        shift_ += 8;
+        ++count_;
+        if (shift_ == 64) {
+            mix(tail_);
+            tail_  = 0;
+            shift_ = 0;
+        }
+    }
+
+    constexpr bool aligned() const { return shift_ == 0; }
+
+    // Contiguous bytes; full words are loaded directly when no partial word
+    // is pending.
+    void bytes(const unsigned char* p, std::size_t n) {
+        while (n != 0 && !aligned()) {
+            byte(*p++);
+            --n;
+        }
+        for (; n >= 8; p += 8, n -= 8) {
+            word(load(p));
+        }
+        while (n-- != 0) {
+            byte(*p++);
+        }
+    }
+
+    constexpr std::uint64_t finish() const {
+        std::uint64_t h = h_;
+        if (shift_ != 0) {
+            auto t = tail_ * k1;
+            t      = std::rotl(t, 31);
+            h ^= t * k2;
+        }
+        return fmix(h ^ count_);
+    }
+
+    static std::uint64_t load(const unsigned char* p) { return load_le(p); }
+};
+
+// Feeds the object representation of one code unit, low byte first.
+template <class CharT>
+constexpr void hash_char(byte_hasher& h, CharT c) {
+    const auto u = static_cast<std::make_unsigned_t<CharT>>(c);
+    for (std::size_t i = 0; i < sizeof(CharT); ++i) {
+        h.byte(static_cast<unsigned char>(u >> (8 * i)));
+    }
+}
+
+template <class CharT>
+std::uint64_t hash_chars(const CharT* p, std::size_t n, std::uint64_t seed) {
+    byte_hasher h(seed);
+    if constexpr (sizeof(CharT) == 1 || std::endian::native == std::endian::little) {
+        h.bytes(reinterpret_cast<const unsigned char*>(p), n * sizeof(CharT));
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            detail::hash_char(h, p[i]);
+        }
+    }
+    return h.finish();
+}
+
+// Hashes the bytes of [p, p + n) before the first byte equal to d, looking
+// for d in the same 8-byte loads that feed the hash. Returns the number of
+// bytes hashed.
+inline std::size_t hash_bytes_before(byte_hasher& h, const unsigned char* p, std::size_t n, unsigned char d) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const std::uint64_t w = byte_hasher::load(p + i);
+        if (const std::uint64_t m = has_byte(w, d)) {
+            const auto k = static_cast<std::size_t>(std::countr_zero(m) / 8);
+            h.bytes(p + i, k);
+            return i + k;
+        }
+        h.word(w);
+    }
+    for (; i < n && p[i] != d; ++i) {
+        h.byte(p[i]);
+    }
+    return i;
+}
+
+} // namespace detail
+
+// ============================================================================
+// hash_before algorithm
+// ============================================================================
+
+struct hash_before_fn {
+    // The hash of the characters before the first one equal to value; equal
+    // to transparent_hash{}(s) for the string s they spell. Bounded
+    // contiguous byte ranges locate the delimiter inside the same 8-byte
+    // loads that feed the hash. Unbounded byte ranges (NTBS) are measured with
+    // the strlen/strchr kernel first, since a word load past the terminator
+    // could leave the object; the second read is of cache-hot data.
+    template <std::ranges::input_range R, class T>
+        requires detail::character<std::remove_cv_t<std::ranges::range_value_t<R>>> &&
+                 detail::indirect_delimiter<std::ranges::iterator_t<R>, T>
+    constexpr std::size_t operator()(R&& r, const T& value, std::uint64_t seed = 0) const {
+        using CharT = std::remove_cv_t<std::ranges::range_value_t<R>>;
+        using I     = std::ranges::iterator_t<R>;
+        using S     = std::ranges::sentinel_t<R>;
+
+        if constexpr (std::contiguous_iterator<I> && sizeof(CharT) == 1 && std::sized_sentinel_for<S, I> &&
+                      detail::kernel_value<CharT, T>) {
+            if (!std::is_constant_evaluated()) {
+                auto                first = std::ranges::begin(r);
+                const auto          n     = static_cast<std::size_t>(std::ranges::end(r) - first);
+                detail::byte_hasher h(seed);
+                const auto*         p = reinterpret_cast<const unsigned char*>(std::to_address(first));
+                if (detail::representable_as<CharT>(value)) {
+                    detail::hash_bytes_before(h, p, n, static_cast<unsigned char>(static_cast<CharT>(value)));
+                } else {
+                    h.bytes(p, n);
+                }
+                return static_cast<std::size_t>(h.finish());
+            }
+        }
+        if constexpr (std::contiguous_iterator<I>) {
+            if (!std::is_constant_evaluated()) {
+                auto       first = std::ranges::begin(r);
+                const auto stop  = detail::find_value(first, std::ranges::end(r), value);
+                return static_cast<std::size_t>(detail::hash_chars(
+                    std::to_address(first), static_cast<std::size_t>(stop - first), seed));
+            }
+        }
+        detail::byte_hasher h(seed);
+        for (auto first = std::ranges::begin(r), last = std::ranges::end(r); !(first == last); ++first) {
+            if (value == *first) {
+                break;
+            }
+            detail::hash_char(h, static_cast<CharT>(*first));
+        }
+        return static_cast<std::size_t>(h.finish());
+    }
+
+    // Unbounded search from an iterator, as views::take_before(i, value).
+    template <class I, class T>
+        requires std::input_iterator<std::decay_t<I>> && (!std::ranges::range<std::remove_cvref_t<I>>) &&
+                 detail::character<std::iter_value_t<std::decay_t<I>>> &&
+                 detail::indirect_delimiter<std::decay_t<I>, T>
+    constexpr std::size_t operator()(I&& i, const T& value, std::uint64_t seed = 0) const {
+        return (*this)(std::ranges::subrange(std::decay_t<I>(std::forward<I>(i)), std::unreachable_sentinel), value,
+                       seed);
+    }
+};
+
+inline constexpr hash_before_fn hash_before;
+
+// ============================================================================
+// transparent_hash
+// ============================================================================
+
+// A transparent hasher for unordered containers keyed by strings. Strings,
+// string views, null-terminated strings and character take_before_views of
+// the same characters all hash alike, so with std::equal_to<> a view can be
+// looked up directly:
+//
+//   std::unordered_map<std::string, int, transparent_hash, std::equal_to<>> m;
+//   m.find(views::take_before(argv[1], '='));
+//
+// hashes the key before '=' and compares it without building a std::string.
+// Views over contiguous bases are located with the delimiter search kernel
+// and hashed as one block; hash_before fuses the two for bounded byte
+// ranges.
+struct transparent_hash {
+    using is_transparent = void;
+
+    template <detail::character CharT, class Traits>
+    std::size_t operator()(std::basic_string_view<CharT, Traits> s) const {
+        return static_cast<std::size_t>(detail::hash_chars(s.data(), s.size(), 0));
+    }
+
+    template <detail::character CharT, class Traits, class Allocator>
+    std::size_t operator()(const std::basic_string<CharT, Traits, Allocator>& s) const {
+        return static_cast<std::size_t>(detail::hash_chars(s.data(), s.size(), 0));
+    }
+
+    template <detail::character CharT>
+    std::size_t operator()(const CharT* s) const {
+        return hash_before(s, CharT());
+    }
+
+    template <class V, class T>
+        requires detail::const_character_view<take_before_view<V, T>>
+    std::size_t operator()(const take_before_view<V, T>& v) const {
+        if constexpr (requires { v.to_span(); }) {
+            auto s = v.to_span();
+            return static_cast<std::size_t>(detail::hash_chars(s.data(), s.size(), 0));
+        } else {
+            // Hash through the view's own iterators so that the view's
+            // delimiter, whatever its type, decides where the key ends.
+            detail::byte_hasher h(0);
+            for (auto c : v) {
+                detail::hash_char(h, static_cast<detail::view_char_t<take_before_view<V, T>>>(c));
+            }
+            return static_cast<std::size_t>(h.finish());
+        }
+    }
+};
+
+} // namespace beman::take_before
+
+// ============================================================================
+// std::hash specialization
+// ============================================================================
+
+namespace std {
+template <class V, class T>
+    requires beman::take_before::detail::const_character_view<beman::take_before::take_before_view<V, T>>
+struct hash<beman::take_before::take_before_view<V, T>> {
+    size_t operator()(const beman::take_before::take_before_view<V, T>& v) const {
+        return beman::take_before::transparent_hash{}(v);
+    }
+};
+} // namespace std
+
+#endif // BEMAN_TAKE_BEFORE_HASH_BEFORE_HPP
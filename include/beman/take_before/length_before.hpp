@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_LENGTH_BEFORE_HPP
+#define BEMAN_TAKE_BEFORE_LENGTH_BEFORE_HPP
+
+#include <beman/take_before/detail/find.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace beman::take_before {
+
+// ============================================================================
+// length_before algorithm
+// ============================================================================
+
+// The strlen of take_before: how many elements precede the first one equal
+// to value, and whether value was found at all. When it was not found,
+// distance is the length of the whole range.
+template <class D>
+struct length_before_result {
+    D    distance;
+    bool found;
+};
+
+struct length_before_fn {
+    // Contiguous byte and wchar_t ranges are searched with the vector kernel.
+    // Other iterators that can be subtracted (random access, including
+    // segmented ones such as std::deque's) run a plain find and subtract;
+    // the rest keep a running count. The search is a plain loop in constant
+    // evaluation.
+    template <std::input_iterator I, std::sentinel_for<I> S, class T>
+        requires detail::indirect_delimiter<I, T>
+    constexpr length_before_result<std::iter_difference_t<I>> operator()(I first, S last, const T& value) const {
+        if constexpr (std::forward_iterator<I> && std::sized_sentinel_for<I, I>) {
+            auto stop = detail::find_value(first, last, value);
+            return {stop - first, !(stop == last)};
+        } else {
+            std::iter_difference_t<I> n = 0;
+            for (; !(first == last); ++first, ++n) {
+                if (value == *first) {
+                    return {n, true};
+                }
+            }
+            return {n, false};
+        }
+    }
+
+    template <std::ranges::input_range R, class T>
+        requires detail::indirect_delimiter<std::ranges::iterator_t<R>, T>
+    constexpr length_before_result<std::ranges::range_difference_t<R>> operator()(R&& r, const T& value) const {
+        return (*this)(std::ranges::begin(r), std::ranges::end(r), value);
+    }
+
+    // Unbounded search from an iterator, as views::take_before(i, value);
+    // found is always true.
+    template <class I, class T>
+        requires std::input_iterator<std::decay_t<I>> && (!std::ranges::range<std::remove_cvref_t<I>>) &&
+                 detail::indirect_delimiter<std::decay_t<I>, T>
+    constexpr length_before_result<std::iter_difference_t<std::decay_t<I>>> operator()(I&& i, const T& value) const {
+        return (*this)(std::decay_t<I>(std::forward<I>(i)), std::unreachable_sentinel, value);
+    }
+};
+
+inline constexpr length_before_fn length_before;
+
+} // namespace beman::take_before
+
+#endif // BEMAN_TAKE_BEFORE_LENGTH_BEFORE_HPP
@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_MAPPED_RECORDS_HPP
+#define BEMAN_TAKE_BEFORE_MAPPED_RECORDS_HPP
+
+#include <beman/take_before/string_table.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#if __has_include(<sys/mman.h>) && __has_include(<sys/stat.h>) && __has_include(<fcntl.h>) && __has_include(<unistd.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BEMAN_TAKE_BEFORE_HAS_MMAP 1
+#else
+#include <fstream>
+#define BEMAN_TAKE_BEFORE_HAS_MMAP 0
+#endif
+
+namespace beman::take_before {
+
+// ============================================================================
+// mapped_file
+// ============================================================================
+
+// How to map a file. Each option is a hint, ignored where the system does
+// not support it.
+struct map_options {
+    bool sequential = true;  // madvise(MADV_SEQUENTIAL): aggressive read-ahead, early reclaim
+    bool will_need  = false; // madvise(MADV_WILLNEED): start reading the whole file now
+    bool huge_pages = false; // madvise(MADV_HUGEPAGE): back the mapping with transparent huge pages
+    bool populate   = false; // mmap(MAP_POPULATE): fault every page in before returning
+};
+
+// A whole file mapped read-only into memory, unmapped on destruction. Where
+// mmap is not available the file is read into memory instead. Failures to
+// open, stat or map the file throw std::system_error.
+class mapped_file {
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+#if !BEMAN_TAKE_BEFORE_HAS_MMAP
+    std::unique_ptr<char[]> contents_;
+#endif
+
+  public:
+    mapped_file() = default;
+
+    explicit mapped_file(const std::filesystem::path& path, const map_options& options = {}) {
+#if BEMAN_TAKE_BEFORE_HAS_MMAP
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            fail(errno, "open", path);
+        }
+        struct ::stat st;
+        if (::fstat(fd, &st) != 0) {
+            const int error = errno;
+            ::close(fd);
+            fail(error, "fstat", path);
+        }
+        if (st.st_size != 0) {
+            int flags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+            if (options.populate) {
+                flags |= MAP_POPULATE;
+            }
+#endif
+            void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, flags, fd, 0);
+            if (p == MAP_FAILED) {
+                const int error = errno;
+                ::close(fd);
+                fail(error, "mmap", path);
+            }
+            data_ = static_cast<const char*>(p);
+            size_ = static_cast<std::size_t>(st.st_size);
+            advise(p, size_, options);
+        }
+        ::close(fd);
+#else
+        (void)options;
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) {
+            fail(ENOENT, "open", path);
+        }
+        size_     = static_cast<std::size_t>(in.tellg());
+        contents_ = std::make_unique<char[]>(size_);
+        in.seekg(0);
+        if (!in.read(contents_.get(), static_cast<std::streamsize>(size_))) {
+            fail(EIO, "read", path);
+        }
+        data_ = contents_.get();
+#endif
+    }
+
+    mapped_file(mapped_file&& other) noexcept { swap(other); }
+
+    mapped_file& operator=(mapped_file&& other) noexcept {
+        mapped_file(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    ~mapped_file() {
+#if BEMAN_TAKE_BEFORE_HAS_MMAP
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+#endif
+    }
+
+    void swap(mapped_file& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+#if !BEMAN_TAKE_BEFORE_HAS_MMAP
+        std::swap(contents_, other.contents_);
+#endif
+    }
+
+    const char* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+
+    std::string_view view() const noexcept { return std::string_view(data_, size_); }
+
+  private:
+    [[noreturn]] static void fail(int error, const char* what, const std::filesystem::path& path) {
+        throw std::system_error(error, std::generic_category(),
+                                std::string("mapped_file: ") + what + ' ' + path.string());
+    }
+
+#if BEMAN_TAKE_BEFORE_HAS_MMAP
+    // Advice is best effort: a kernel that rejects it still maps the file.
+    static void advise([[maybe_unused]] void* p, [[maybe_unused]] std::size_t n,
+                       [[maybe_unused]] const map_options& options) {
+#if defined(MADV_SEQUENTIAL)
+        if (options.sequential) {
+            ::madvise(p, n, MADV_SEQUENTIAL);
+        }
+#endif
+#if defined(MADV_WILLNEED)
+        if (options.will_need) {
+            ::madvise(p, n, MADV_WILLNEED);
+        }
+#endif
+#if defined(MADV_HUGEPAGE)
+        if (options.huge_pages) {
+            ::madvise(p, n, MADV_HUGEPAGE);
+        }
+#endif
+    }
+#endif
+};
+
+// ============================================================================
+// mapped_records
+// ============================================================================
+
+// The delimited records of a file, mapped with mapped_file and split lazily
+// as a string_table_view: each record is a std::string_view into the mapping
+// found by the delimiter search kernel when the iterator reaches it, and no
+// record is copied. As with string_table_view, a delimiter at the very end
+// of the file does not start an empty record and a final record without a
+// delimiter is still produced. The records are valid while the
+// mapped_records object lives, so it is not a borrowed range.
+class mapped_records : public std::ranges::view_interface<mapped_records> {
+    mapped_file file_;
+    char        delimiter_ = '\n';
+
+  public:
+    mapped_records() = default;
+
+    explicit mapped_records(const std::filesystem::path& path, char delimiter = '\n', const map_options& options = {})
+        : file_(path, options), delimiter_(delimiter) {}
+
+    const mapped_file& file() const noexcept { return file_; }
+    char               delimiter() const noexcept { return delimiter_; }
+
+    string_table_view::iterator begin() const { return records().begin(); }
+    string_table_view::iterator end() const { return records().end(); }
+
+  private:
+    string_table_view records() const { return string_table_view(file_.view(), delimiter_); }
+};
+
+} // namespace beman::take_before
+
+#endif // BEMAN_TAKE_BEFORE_MAPPED_RECORDS_HPP
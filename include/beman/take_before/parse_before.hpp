@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_PARSE_BEFORE_HPP
+#define BEMAN_TAKE_BEFORE_PARSE_BEFORE_HPP
+
+#include <beman/take_before/detail/find.hpp>
+#include <beman/take_before/detail/swar.hpp>
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <version>
+
+namespace beman::take_before {
+
+// ============================================================================
+// parse_before algorithm
+// ============================================================================
+
+// The number spelled by the characters before the first one equal to the
+// delimiter. end is where the field ends: the delimiter, or the end of the
+// input. ec is std::errc() when the whole field is a number in the
+// std::from_chars format (base 10, no leading '+' or whitespace),
+// invalid_argument when it is not, and result_out_of_range when it does not
+// fit in T; value is T() unless ec is std::errc(). The result converts to
+// one with std::ranges::dangling as end, for an rvalue range that does not
+// borrow.
+template <class T, class I>
+struct parse_before_result {
+    T                     value;
+    [[no_unique_address]] I end;
+    std::errc             ec;
+
+    template <class I2>
+        requires std::convertible_to<const I&, I2>
+    constexpr operator parse_before_result<T, I2>() const& {
+        return {value, end, ec};
+    }
+
+    template <class I2>
+        requires std::convertible_to<I, I2>
+    constexpr operator parse_before_result<T, I2>() && {
+        return {std::move(value), std::move(end), ec};
+    }
+};
+
+namespace detail {
+
+template <class T>
+concept parse_integer = std::integral<T> && !std::same_as<T, bool> && sizeof(T) <= sizeof(std::uint64_t);
+
+#if defined(__cpp_lib_to_chars)
+template <class T>
+concept parse_number = parse_integer<T> || std::floating_point<T>;
+#else
+template <class T>
+concept parse_number = parse_integer<T>;
+#endif
+
+template <class I, class S>
+concept parse_before_kernel_applicable =
+    std::contiguous_iterator<I> && std::sized_sentinel_for<S, I> &&
+    std::same_as<std::remove_cv_t<std::iter_value_t<I>>, char>;
+
+// Accumulates decimal digits into m, eight at a time, while [first, last)
+// holds at least eight more digits none of which is the delimiter d and m is
+// small enough that m * 10^8 + 99999999 cannot wrap. Sets overflow once m
+// exceeds limit; the caller continues with the scalar loop either way.
+template <class I, class S>
+void parse_digits_swar(I& first, const S& last, const char* d, std::uint64_t& m, std::uint64_t limit,
+                       bool& overflow) {
+    const auto* p = reinterpret_cast<const unsigned char*>(std::to_address(first));
+    const auto  n = static_cast<std::size_t>(last - first);
+
+    std::size_t i = 0;
+    for (; !overflow && i + 8 <= n && m < 100000000000ULL; i += 8) {
+        const std::uint64_t w = load_le(p + i);
+        if (!all_digits(w) || (d != nullptr && has_byte(w, static_cast<unsigned char>(*d)))) {
+            break;
+        }
+        m        = m * 100000000 + eight_digits(w);
+        overflow = m > limit;
+    }
+    first += static_cast<std::iter_difference_t<I>>(i);
+}
+
+template <class T, class I, class S, class V>
+constexpr parse_before_result<T, I> parse_integer_before(I first, const S& last, const V& value) {
+    using U = std::make_unsigned_t<T>;
+
+    const auto at_end = [&] { return first == last || value == *first; };
+    const auto fail   = [&](std::errc ec) {
+        return parse_before_result<T, I>{T(), find_value(std::move(first), last, value), ec};
+    };
+
+    bool negative = false;
+    if constexpr (std::is_signed_v<T>) {
+        if (!at_end() && *first == '-') {
+            negative = true;
+            ++first;
+        }
+    }
+    const std::uint64_t limit = std::uint64_t(U(std::numeric_limits<T>::max())) + (negative ? 1 : 0);
+    if (at_end()) {
+        return fail(std::errc::invalid_argument);
+    }
+
+    std::uint64_t m        = 0;
+    bool          overflow = false;
+    if constexpr (parse_before_kernel_applicable<I, S> && kernel_value<char, V>) {
+        if (!std::is_constant_evaluated()) {
+            const char d = static_cast<char>(value);
+            parse_digits_swar(first, last, representable_as<char>(value) ? &d : nullptr, m, limit, overflow);
+        }
+    }
+    for (; !at_end(); ++first) {
+        const char c = *first;
+        if (c < '0' || c > '9') {
+            return fail(std::errc::invalid_argument);
+        }
+        const auto digit = static_cast<std::uint64_t>(c - '0');
+        if (overflow || m > (limit - digit) / 10) {
+            overflow = true;
+        } else {
+            m = m * 10 + digit;
+        }
+    }
+    if (overflow) {
+        return {T(), std::move(first), std::errc::result_out_of_range};
+    }
+    const U magnitude = static_cast<U>(m);
+    return {negative ? static_cast<T>(U(0) - magnitude) : static_cast<T>(magnitude), std::move(first), std::errc()};
+}
+
+#if defined(__cpp_lib_to_chars)
+
+template <class T>
+std::errc from_chars_exact(const char* first, const char* last, T& value) {
+    const auto [ptr, ec] = std::from_chars(first, last, value);
+    if (ec == std::errc() && ptr != last) {
+        return std::errc::invalid_argument;
+    }
+    return ec;
+}
+
+// Floating-point fields go through std::from_chars. Contiguous fields are
+// located with the delimiter search kernel and parsed in place; others are
+// gathered into a local buffer as they are scanned.
+template <class T, class I, class S, class V>
+parse_before_result<T, I> parse_floating_before(I first, const S& last, const V& value) {
+    T value_out{};
+    if constexpr (std::contiguous_iterator<I> && std::same_as<std::remove_cv_t<std::iter_value_t<I>>, char>) {
+        const auto stop = find_value(first, last, value);
+        const char* p   = std::to_address(first);
+        const auto  ec  = from_chars_exact(p, p + (stop - first), value_out);
+        return {ec == std::errc() ? value_out : T(), stop, ec};
+    } else {
+        char        buffer[64];
+        std::size_t n = 0;
+        std::string spill;
+        for (; !(first == last) && !(value == *first); ++first) {
+            if (n == sizeof(buffer)) {
+                spill.append(buffer, n);
+                n = 0;
+            }
+            buffer[n++] = *first;
+        }
+        std::errc ec;
+        if (spill.empty()) {
+            ec = from_chars_exact(buffer, buffer + n, value_out);
+        } else {
+            spill.append(buffer, n);
+            ec = from_chars_exact(spill.data(), spill.data() + spill.size(), value_out);
+        }
+        return {ec == std::errc() ? value_out : T(), std::move(first), ec};
+    }
+}
+
+#endif
+
+} // namespace detail
+
+template <class T>
+struct parse_before_fn {
+    // Integers are parsed while the delimiter is searched for, one pass over
+    // any input range of char and in constant evaluation. Contiguous input
+    // consumes eight digits per load (SWAR) for the first 16 or so digits,
+    // which covers every 64-bit value. Floating-point values are parsed with
+    // std::from_chars.
+    template <std::input_iterator I, std::sentinel_for<I> S, class V>
+        requires detail::parse_number<T> && std::same_as<std::remove_cv_t<std::iter_value_t<I>>, char> &&
+                 detail::indirect_delimiter<I, V>
+    constexpr parse_before_result<T, I> operator()(I first, S last, const V& value) const {
+        if constexpr (detail::parse_integer<T>) {
+            return detail::parse_integer_before<T>(std::move(first), last, value);
+        } else {
+            return detail::parse_floating_before<T>(std::move(first), last, value);
+        }
+    }
+
+    template <std::ranges::input_range R, class V>
+        requires detail::parse_number<T> && std::same_as<std::remove_cv_t<std::ranges::range_value_t<R>>, char> &&
+                 detail::indirect_delimiter<std::ranges::iterator_t<R>, V>
+    constexpr parse_before_result<T, std::ranges::borrowed_iterator_t<R>> operator()(R&& r, const V& value) const {
+        return (*this)(std::ranges::begin(r), std::ranges::end(r), value);
+    }
+
+    // Unbounded input from an iterator, as views::take_before(i, value).
+    template <class I, class V>
+        requires std::input_iterator<std::decay_t<I>> && (!std::ranges::range<std::remove_cvref_t<I>>) &&
+                 detail::parse_number<T> && std::same_as<std::remove_cv_t<std::iter_value_t<std::decay_t<I>>>, char> &&
+                 detail::indirect_delimiter<std::decay_t<I>, V>
+    constexpr parse_before_result<T, std::decay_t<I>> operator()(I&& i, const V& value) const {
+        return (*this)(std::decay_t<I>(std::forward<I>(i)), std::unreachable_sentinel, value);
+    }
+};
+
+template <class T>
+inline constexpr parse_before_fn<T> parse_before;
+
+} // namespace beman::take_before
+
+#endif // BEMAN_TAKE_BEFORE_PARSE_BEFORE_HPP
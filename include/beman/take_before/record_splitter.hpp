@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_RECORD_SPLITTER_HPP
+#define BEMAN_TAKE_BEFORE_RECORD_SPLITTER_HPP
+
+#include <beman/take_before/detail/find.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace beman::take_before {
+
+// ============================================================================
+// basic_record_splitter
+// ============================================================================
+
+// Splits input that arrives in chunks (read() results, decompressor output)
+// into delimited records. feed(chunk, f) scans the chunk with the delimiter
+// search kernel and calls f with each record it completes, in order: a
+// record that lies within the chunk is a basic_string_view into it, without
+// copying, and a record that began in an earlier chunk is a view of the
+// carry buffer, where the unfinished tail of each chunk is kept. Either view
+// is valid only during the call to f. finish(f) ends the input and hands out
+// a final record that has no delimiter, unless it is empty, as std::getline
+// does.
+//
+// Besides the caller's chunk, memory is the carry buffer: at most the
+// longest record. A record longer than max_record (unbounded by default)
+// throws std::length_error instead of reaching f: one within a chunk when it
+// is found, one that crosses chunks as soon as the carry would exceed it.
+// The records before it have been handed out.
+template <class CharT>
+class basic_record_splitter {
+    std::basic_string<CharT> carry_;
+    CharT                    delimiter_;
+    std::size_t              max_record_;
+
+    void check(std::size_t added, std::size_t kept) const {
+        if (added > max_record_ - kept) {
+            throw std::length_error("basic_record_splitter: record longer than max_record");
+        }
+    }
+
+    void carry(const CharT* first, const CharT* last) {
+        check(static_cast<std::size_t>(last - first), carry_.size());
+        carry_.append(first, last);
+    }
+
+  public:
+    static constexpr std::size_t unbounded = static_cast<std::size_t>(-1);
+
+    explicit basic_record_splitter(CharT delimiter, std::size_t max_record = unbounded)
+        : delimiter_(delimiter), max_record_(max_record) {}
+
+    CharT       delimiter() const noexcept { return delimiter_; }
+    std::size_t max_record() const noexcept { return max_record_; }
+
+    // The length of the record begun but not finished by the chunks so far.
+    std::size_t carried() const noexcept { return carry_.size(); }
+
+    template <class F>
+        requires std::invocable<F&, std::basic_string_view<CharT>>
+    void feed(std::basic_string_view<CharT> chunk, F&& f) {
+        const CharT* p    = chunk.data();
+        const CharT* last = p + chunk.size();
+        for (;;) {
+            const CharT* stop = detail::find_value(p, last, delimiter_);
+            if (stop == last) {
+                break;
+            }
+            if (carry_.empty()) {
+                check(static_cast<std::size_t>(stop - p), 0);
+                std::invoke(f, std::basic_string_view<CharT>(p, static_cast<std::size_t>(stop - p)));
+            } else {
+                carry(p, stop);
+                std::invoke(f, std::basic_string_view<CharT>(carry_));
+                carry_.clear();
+            }
+            p = stop + 1;
+        }
+        carry(p, last);
+    }
+
+    // Returns whether there was a final record.
+    template <class F>
+        requires std::invocable<F&, std::basic_string_view<CharT>>
+    bool finish(F&& f) {
+        if (carry_.empty()) {
+            return false;
+        }
+        std::invoke(f, std::basic_string_view<CharT>(carry_));
+        carry_.clear();
+        return true;
+    }
+};
+
+using record_splitter  = basic_record_splitter<char>;
+using wrecord_splitter = basic_record_splitter<wchar_t>;
+
+} // namespace beman::take_before
+
+#endif // BEMAN_TAKE_BEFORE_RECORD_SPLITTER_HPP
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_RESUMABLE_SCANNER_HPP
+#define BEMAN_TAKE_BEFORE_RESUMABLE_SCANNER_HPP
+
+#include <beman/take_before/detail/find.hpp>
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <utility>
+
+namespace beman::take_before {
+
+// ============================================================================
+// resumable_scanner
+// ============================================================================
+
+enum class scan_status {
+    found,           // the delimiter is at position
+    need_more,       // the whole buffer is searched; append and scan again
+    budget_exhausted // the budget ran out first; scan again to go on
+};
+
+struct resumable_scan_result {
+    scan_status status;
+    std::size_t position; // of the delimiter if found, else how far the buffer is searched
+
+    constexpr explicit operator bool() const noexcept { return status == scan_status::found; }
+};
+
+// The search for a delimiter in a buffer that grows by appends, such as a
+// receive buffer filled by small network reads. Instead of searching the
+// whole buffer again on every append, which is quadratic in the length of a
+// record that arrives in many pieces, the scanner remembers how far it has
+// searched and continues from there. It keeps an offset, not a pointer, so
+// the buffer may reallocate between scans. A budget bounds the elements
+// examined per call, keeping an event loop responsive while a long record
+// is searched.
+//
+// A found delimiter stays found until the caller takes the record out of
+// the front of the buffer and reports how much it removed with consume(n).
+template <class T>
+class resumable_scanner {
+    T           delimiter_;
+    std::size_t searched_ = 0;
+
+  public:
+    static constexpr std::size_t unbounded = static_cast<std::size_t>(-1);
+
+    constexpr explicit resumable_scanner(T delimiter) : delimiter_(std::move(delimiter)) {}
+
+    constexpr const T&    delimiter() const noexcept { return delimiter_; }
+    constexpr std::size_t searched() const noexcept { return searched_; }
+
+    // Continues the search of buffer, which holds at least the elements
+    // searched before, examining at most budget more of them.
+    template <std::ranges::contiguous_range R>
+        requires std::ranges::sized_range<R> &&
+                 detail::indirect_delimiter<std::ranges::iterator_t<R>, T>
+    constexpr resumable_scan_result scan(R&& buffer, std::size_t budget = unbounded) {
+        const auto* first = std::ranges::data(buffer);
+        const auto  size  = static_cast<std::size_t>(std::ranges::size(buffer));
+        const auto  from  = std::min(searched_, size);
+        const auto  to    = from + std::min(budget, size - from);
+
+        const auto* stop = detail::find_value(first + from, first + to, delimiter_);
+        searched_        = static_cast<std::size_t>(stop - first);
+        if (searched_ != to) {
+            return {scan_status::found, searched_};
+        }
+        return {to == size ? scan_status::need_more : scan_status::budget_exhausted, searched_};
+    }
+
+    // The caller removed the first n elements of the buffer, usually a
+    // found record and its delimiter.
+    constexpr void consume(std::size_t n) noexcept { searched_ -= std::min(n, searched_); }
+
+    // The buffer was replaced; search it from the start.
+    constexpr void reset() noexcept { searched_ = 0; }
+};
+
+} // namespace beman::take_before
+
+#endif // BEMAN_TAKE_BEFORE_RESUMABLE_SCANNER_HPP
@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_SCAN_BEFORE_WITH_POSITION_HPP
+#define BEMAN_TAKE_BEFORE_SCAN_BEFORE_WITH_POSITION_HPP
+
+#include <beman/take_before/detail/find.hpp>
+#include <beman/take_before/detail/swar.hpp>
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace beman::take_before {
+
+// ============================================================================
+// scan_before_with_position algorithm
+// ============================================================================
+
+// Where the elements before the first one equal to the delimiter end, and
+// the text position of that point: end is the delimiter or the end of the
+// input, lines_crossed the number of '\n' elements before end, and column
+// the number of elements between the last of those newlines and end. With
+// no newline crossed, column is the distance from the start of the scan, to
+// be added to the column the scan started at. The result converts to one
+// with std::ranges::dangling as end, for an rvalue range that does not
+// borrow.
+template <class I, class D>
+struct scan_position_result {
+    [[no_unique_address]] I end;
+    D                       lines_crossed;
+    D                       column;
+
+    template <class I2>
+        requires std::convertible_to<const I&, I2>
+    constexpr operator scan_position_result<I2, D>() const& {
+        return {end, lines_crossed, column};
+    }
+
+    template <class I2>
+        requires std::convertible_to<I, I2>
+    constexpr operator scan_position_result<I2, D>() && {
+        return {std::move(end), lines_crossed, column};
+    }
+};
+
+namespace detail {
+
+struct byte_position {
+    std::size_t end;
+    std::size_t lines;
+    std::size_t line_start;
+};
+
+// Bounded contiguous bytes, eight per load: exact masks of the newlines and
+// of the delimiter d (if representable), the newlines below the first
+// delimiter counted with popcount and the highest of them starting the
+// line. The scan and the counting are one pass.
+inline byte_position scan_position_bytes(const unsigned char* p, std::size_t n, const unsigned char* d) {
+    std::size_t lines      = 0;
+    std::size_t line_start = 0;
+    std::size_t i          = 0;
+    for (; i + 8 <= n; i += 8) {
+        const std::uint64_t w     = load_le(p + i);
+        std::uint64_t       nl    = byte_mask(w, '\n');
+        const std::uint64_t stops = d != nullptr ? byte_mask(w, *d) : 0;
+        if (stops != 0) {
+            nl &= (std::uint64_t(1) << std::countr_zero(stops)) - 1;
+        }
+        lines += static_cast<std::size_t>(std::popcount(nl));
+        if (nl != 0) {
+            line_start = i + static_cast<std::size_t>((63 - std::countl_zero(nl)) / 8) + 1;
+        }
+        if (stops != 0) {
+            return {i + static_cast<std::size_t>(std::countr_zero(stops) / 8), lines, line_start};
+        }
+    }
+    for (; i < n && !(d != nullptr && p[i] == *d); ++i) {
+        if (p[i] == '\n') {
+            ++lines;
+            line_start = i + 1;
+        }
+    }
+    return {i, lines, line_start};
+}
+
+} // namespace detail
+
+struct scan_before_with_position_fn {
+    // Contiguous byte ranges take the word-at-a-time kernel, outside of
+    // constant evaluation; everything else is one loop that counts as it
+    // searches.
+    template <std::input_iterator I, std::sentinel_for<I> S, class T>
+        requires std::integral<std::iter_value_t<I>> &&
+                 detail::indirect_delimiter<I, T>
+    constexpr scan_position_result<I, std::iter_difference_t<I>> operator()(I first, S last, const T& value) const {
+        using E = std::remove_cv_t<std::iter_value_t<I>>;
+        using D = std::iter_difference_t<I>;
+        if constexpr (std::contiguous_iterator<I> && std::sized_sentinel_for<S, I> && detail::byte_element<E> &&
+                      detail::kernel_value<E, T>) {
+            if (!std::is_constant_evaluated()) {
+                const auto  e = detail::to_byte(static_cast<E>(value));
+                const auto  n = static_cast<std::size_t>(last - first);
+                const auto* p = reinterpret_cast<const unsigned char*>(std::to_address(first));
+                const auto  r = detail::scan_position_bytes(p, n, detail::representable_as<E>(value) ? &e : nullptr);
+                return {first + static_cast<D>(r.end), static_cast<D>(r.lines), static_cast<D>(r.end - r.line_start)};
+            }
+        }
+        D lines  = 0;
+        D column = 0;
+        for (; !(first == last) && !(value == *first); ++first) {
+            if (*first == static_cast<E>('\n')) {
+                ++lines;
+                column = 0;
+            } else {
+                ++column;
+            }
+        }
+        return {std::move(first), lines, column};
+    }
+
+    template <std::ranges::input_range R, class T>
+        requires std::integral<std::ranges::range_value_t<R>> &&
+                 detail::indirect_delimiter<std::ranges::iterator_t<R>, T>
+    constexpr scan_position_result<std::ranges::borrowed_iterator_t<R>, std::ranges::range_difference_t<R>>
+    operator()(R&& r, const T& value) const {
+        return (*this)(std::ranges::begin(r), std::ranges::end(r), value);
+    }
+
+    // Unbounded input from an iterator, as views::take_before(i, value).
+    template <class I, class T>
+        requires std::input_iterator<std::decay_t<I>> && (!std::ranges::range<std::remove_cvref_t<I>>) &&
+                 std::integral<std::iter_value_t<std::decay_t<I>>> &&
+                 detail::indirect_delimiter<std::decay_t<I>, T>
+    constexpr scan_position_result<std::decay_t<I>, std::iter_difference_t<std::decay_t<I>>>
+    operator()(I&& i, const T& value) const {
+        return (*this)(std::decay_t<I>(std::forward<I>(i)), std::unreachable_sentinel, value);
+    }
+};
+
+inline constexpr scan_before_with_position_fn scan_before_with_position;
+
+} // namespace beman::take_before
+
+#endif // BEMAN_TAKE_BEFORE_SCAN_BEFORE_WITH_POSITION_HPP
@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_STREAMBUF_RECORDS_HPP
+#define BEMAN_TAKE_BEFORE_STREAMBUF_RECORDS_HPP
+
+#include <beman/take_before/detail/find.hpp>
+
+#include <climits>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace beman::take_before {
+
+namespace detail {
+
+// The get area of a basic_streambuf is protected. Pointers to its members,
+// formed through a derived class, can be applied to any streambuf.
+template <class CharT, class Traits>
+struct streambuf_access : std::basic_streambuf<CharT, Traits> {
+    using base = std::basic_streambuf<CharT, Traits>;
+
+    static CharT* get_begin(base& b) { return (b.*&streambuf_access::gptr)(); }
+    static CharT* get_end(base& b) { return (b.*&streambuf_access::egptr)(); }
+
+    static void consume(base& b, std::size_t n) {
+        for (; n > INT_MAX; n -= INT_MAX) {
+            (b.*&streambuf_access::gbump)(INT_MAX);
+        }
+        (b.*&streambuf_access::gbump)(static_cast<int>(n));
+    }
+};
+
+// The first position in [first, first + n) whose character Traits::eq the
+// delimiter: the delimiter search kernel for std::char_traits, Traits::find
+// for others.
+template <class CharT, class Traits>
+const CharT* find_in_get_area(const CharT* first, std::size_t n, CharT delimiter) {
+    if constexpr (std::is_same_v<Traits, std::char_traits<CharT>> && (byte_element<CharT> || wide_element<CharT>)) {
+        return find_value_n(first, n, delimiter);
+    } else {
+        const CharT* p = Traits::find(first, n, delimiter);
+        return p ? p : first + n;
+    }
+}
+
+} // namespace detail
+
+// ============================================================================
+// basic_streambuf_records
+// ============================================================================
+
+// The records of a stream buffer separated by a delimiter, read straight
+// from its get area: each record is searched for in [gptr(), egptr()) with
+// the delimiter search kernel and, when it lies within the get area, is
+// returned as a string_view into it, without copying. The buffer refills
+// only when its get area is used up; a record that spans refills is
+// gathered into a carry string, which is then what the view refers to.
+// Stream buffers without a get area (such as std::cin's while synchronized
+// with stdio) are read one character at a time.
+//
+// Like std::getline, the delimiter is consumed and not part of the record,
+// and a final record without a delimiter is produced unless it is empty. A
+// record stays valid until the iterator is incremented. The view reads the
+// stream buffer directly; the state of an istream using it is not updated.
+template <class CharT, class Traits = std::char_traits<CharT>>
+class basic_streambuf_records : public std::ranges::view_interface<basic_streambuf_records<CharT, Traits>> {
+    using streambuf_type = std::basic_streambuf<CharT, Traits>;
+    using access         = detail::streambuf_access<CharT, Traits>;
+
+    streambuf_type*                       buf_       = nullptr;
+    CharT                                 delimiter_ = CharT();
+    std::basic_string<CharT, Traits>      carry_;
+    std::basic_string_view<CharT, Traits> record_;
+    bool                                  done_ = false;
+
+    // Reads the next record into record_; false at the end of the input.
+    bool next() {
+        carry_.clear();
+        bool carried = false;
+        while (!Traits::eq_int_type(buf_->sgetc(), Traits::eof())) {
+            const CharT* first = access::get_begin(*buf_);
+            const CharT* last  = access::get_end(*buf_);
+            if (first == last) {
+                // No get area: sgetc() peeked through underflow.
+                const CharT c = Traits::to_char_type(buf_->sbumpc());
+                if (Traits::eq(c, delimiter_)) {
+                    record_ = carry_;
+                    return true;
+                }
+                carry_.push_back(c);
+                carried = true;
+                continue;
+            }
+            const auto   n    = static_cast<std::size_t>(last - first);
+            const CharT* stop = detail::find_in_get_area<CharT, Traits>(first, n, delimiter_);
+            if (stop != last) {
+                if (carried) {
+                    carry_.append(first, stop);
+                    record_ = carry_;
+                } else {
+                    record_ = std::basic_string_view<CharT, Traits>(first, static_cast<std::size_t>(stop - first));
+                }
+                access::consume(*buf_, static_cast<std::size_t>(stop - first) + 1);
+                return true;
+            }
+            carry_.append(first, last);
+            carried = true;
+            access::consume(*buf_, n);
+        }
+        record_ = carry_;
+        return !carry_.empty();
+    }
+
+  public:
+    class iterator {
+        basic_streambuf_records* parent_ = nullptr;
+
+      public:
+        using iterator_concept = std::input_iterator_tag;
+        using value_type       = std::basic_string_view<CharT, Traits>;
+        using difference_type  = std::ptrdiff_t;
+
+        iterator() = default;
+        constexpr explicit iterator(basic_streambuf_records& parent) : parent_(std::addressof(parent)) {}
+
+        iterator(const iterator&)            = delete;
+        iterator(iterator&&)                 = default;
+        iterator& operator=(const iterator&) = delete;
+        iterator& operator=(iterator&&)      = default;
+
+        value_type operator*() const { return parent_->record_; }
+
+        iterator& operator++() {
+            parent_->done_ = !parent_->next();
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator& x, std::default_sentinel_t) { return x.at_end(); }
+
+      private:
+        bool at_end() const { return parent_->done_; }
+    };
+
+    basic_streambuf_records() = default;
+
+    basic_streambuf_records(streambuf_type& buf, CharT delimiter) : buf_(std::addressof(buf)), delimiter_(delimiter) {}
+
+    CharT delimiter() const noexcept { return delimiter_; }
+
+    // Reads the first record. Like std::ranges::istream_view, begin() is
+    // called once per view.
+    iterator begin() {
+        done_ = !next();
+        return iterator(*this);
+    }
+
+    std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+};
+
+template <class CharT, class Traits>
+basic_streambuf_records(std::basic_streambuf<CharT, Traits>&, CharT) -> basic_streambuf_records<CharT, Traits>;
+
+using streambuf_records  = basic_streambuf_records<char>;
+using wstreambuf_records = basic_streambuf_records<wchar_t>;
+
+} // namespace beman::take_before
+
+#endif // BEMAN_TAKE_BEFORE_STREAMBUF_RECORDS_HPP
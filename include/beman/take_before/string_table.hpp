@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_STRING_TABLE_HPP
+#define BEMAN_TAKE_BEFORE_STRING_TABLE_HPP
+
+#include <beman/take_before/detail/find.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+
+namespace beman::take_before {
+
+// ============================================================================
+// basic_string_table_view class template
+// ============================================================================
+
+// A view of the strings packed back to back in a buffer, each one ended by a
+// terminator (NUL by default): ELF string tables, /proc/<pid>/cmdline and
+// /proc/<pid>/environ, `find -print0` output. Every element is the
+// take_before segment of the remaining buffer, returned as a borrowed
+// basic_string_view. The iterator remembers where the current string ends, so
+// advancing resumes the search right after it and no byte is scanned twice.
+//
+// A terminator at the very end of the buffer closes the last string and does
+// not start an empty one; a final string without a terminator is still
+// produced.
+template <class CharT>
+class basic_string_table_view : public std::ranges::view_interface<basic_string_table_view<CharT>> {
+    const CharT* first_     = nullptr;
+    const CharT* last_      = nullptr;
+    CharT        delimiter_ = CharT();
+
+  public:
+    class iterator {
+        const CharT* cur_       = nullptr; // start of the current string
+        const CharT* stop_      = nullptr; // its terminator, or last_
+        const CharT* last_      = nullptr;
+        CharT        delimiter_ = CharT();
+
+        friend class basic_string_table_view;
+
+        constexpr iterator(const CharT* cur, const CharT* last, CharT delimiter)
+            : cur_(cur), stop_(cur), last_(last), delimiter_(delimiter) {
+            if (cur_ != last_) {
+                stop_ = detail::find_value(cur_, last_, delimiter_);
+            }
+        }
+
+      public:
+        using value_type        = std::basic_string_view<CharT>;
+        using difference_type   = std::ptrdiff_t;
+        using iterator_concept  = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+
+        iterator() = default;
+
+        constexpr value_type operator*() const { return value_type(cur_, static_cast<std::size_t>(stop_ - cur_)); }
+
+        constexpr iterator& operator++() {
+            cur_  = stop_ == last_ ? last_ : stop_ + 1;
+            stop_ = cur_ == last_ ? last_ : detail::find_value(cur_, last_, delimiter_);
+            return *this;
+        }
+
+        constexpr iterator operator++(int) {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        friend constexpr bool operator==(const iterator& x, const iterator& y) { return x.cur_ == y.cur_; }
+    };
+
+    basic_string_table_view() = default;
+
+    constexpr explicit basic_string_table_view(std::basic_string_view<CharT> table, CharT delimiter = CharT())
+        : first_(table.data()), last_(table.data() + table.size()), delimiter_(delimiter) {}
+
+    constexpr std::basic_string_view<CharT> table() const {
+        return std::basic_string_view<CharT>(first_, static_cast<std::size_t>(last_ - first_));
+    }
+
+    constexpr CharT delimiter() const { return delimiter_; }
+
+    constexpr iterator begin() const { return iterator(first_, last_, delimiter_); }
+
+    constexpr iterator end() const { return iterator(last_, last_, delimiter_); }
+};
+
+using string_table_view    = basic_string_table_view<char>;
+using wstring_table_view   = basic_string_table_view<wchar_t>;
+using u8string_table_view  = basic_string_table_view<char8_t>;
+using u16string_table_view = basic_string_table_view<char16_t>;
+using u32string_table_view = basic_string_table_view<char32_t>;
+
+} // namespace beman::take_before
+
+// ============================================================================
+// enable_borrowed_range specialization
+// ============================================================================
+
+namespace std::ranges {
+template <class CharT>
+constexpr bool enable_borrowed_range<beman::take_before::basic_string_table_view<CharT>> = true;
+} // namespace std::ranges
+
+// ============================================================================
+// views::string_table
+// ============================================================================
+
+namespace beman::take_before::views {
+
+struct string_table_fn {
+    template <std::ranges::contiguous_range R, class CharT = std::remove_cv_t<std::ranges::range_value_t<R>>>
+        requires std::ranges::sized_range<R> && std::ranges::borrowed_range<R>
+    constexpr auto operator()(R&& r, std::type_identity_t<CharT> delimiter = CharT()) const {
+        return basic_string_table_view<CharT>(
+            std::basic_string_view<CharT>(std::ranges::data(r), static_cast<std::size_t>(std::ranges::size(r))),
+            delimiter);
+    }
+};
+
+inline constexpr string_table_fn string_table;
+
+} // namespace beman::take_before::views
+
+#endif // BEMAN_TAKE_BEFORE_STRING_TABLE_HPP
@@ -3,11 +3,19 @@
 #ifndef BEMAN_TAKE_BEFORE_TAKE_BEFORE_HPP
 #define BEMAN_TAKE_BEFORE_TAKE_BEFORE_HPP
 
+#include <beman/take_before/detail/find.hpp>
+#include <beman/take_before/detail/swar.hpp>
+
 #include <algorithm>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 
@@ -46,13 +54,174 @@ constexpr bool tidy_obj = // exposition only
 template <typename T>
 using movable_box = std::optional<T>;
 
+namespace detail {
+
+// Character types for which std::basic_string_view is usable.
+template <class C>
+concept character = std::same_as<C, char> || std::same_as<C, wchar_t> || std::same_as<C, char8_t> ||
+                    std::same_as<C, char16_t> || std::same_as<C, char32_t>;
+
+// The elements of contiguous range r before the first one equal to value, as
+// a span located by the delimiter search kernel.
+template <std::ranges::contiguous_range R, class T>
+constexpr auto span_before(R& r, const T& value) {
+    using E    = std::remove_reference_t<std::ranges::range_reference_t<R>>;
+    auto first = std::ranges::begin(r);
+    auto last  = detail::find_value(first, std::ranges::end(r), value);
+    return std::span<E>(std::to_address(first), static_cast<std::size_t>(last - first));
+}
+
+struct view_access;
+
+// iterator_category for the iterators of the views in the other headers that
+// wrap a base iterator together with some scanning state: forward when the
+// base is, and only then.
+template <class Base>
+struct stateful_iterator_category {};
+
+template <class Base>
+    requires std::ranges::forward_range<Base>
+struct stateful_iterator_category<Base> {
+    using iterator_category = std::conditional_t<std::is_reference_v<std::ranges::range_reference_t<Base>>,
+                                                 std::forward_iterator_tag,
+                                                 std::input_iterator_tag>;
+};
+
+// [range.nonprop.cache] non-propagating-cache: an optional<T> that is emptied
+// rather than copied along with the view holding it, since the cached value
+// may point into that view's base.
+template <class T>
+class non_propagating_cache : public std::optional<T> {
+  public:
+    non_propagating_cache() = default;
+    constexpr non_propagating_cache(const non_propagating_cache&) noexcept : std::optional<T>() {}
+    constexpr non_propagating_cache(non_propagating_cache&& other) noexcept : std::optional<T>() { other.reset(); }
+    constexpr non_propagating_cache& operator=(const non_propagating_cache& other) noexcept {
+        if (this != std::addressof(other)) {
+            this->reset();
+        }
+        return *this;
+    }
+    constexpr non_propagating_cache& operator=(non_propagating_cache&& other) noexcept {
+        this->reset();
+        other.reset();
+        return *this;
+    }
+};
+
+// [range.approximately.sized] approximately_sized_range (P2846), falling back
+// to sized_range where the standard library has no ranges::reserve_hint.
+#if defined(__cpp_lib_ranges_reserve_hint)
+template <class R>
+concept approximately_sized_range = std::ranges::approximately_sized_range<R>;
+
+template <class R>
+constexpr auto reserve_hint(R& r) {
+    return std::ranges::reserve_hint(r);
+}
+#else
+template <class R>
+concept approximately_sized_range = std::ranges::sized_range<R>;
+
+template <class R>
+constexpr auto reserve_hint(R& r) {
+    return std::ranges::size(r);
+}
+#endif
+
+} // namespace detail
+
+// ============================================================================
+// Delimiter wrappers
+// ============================================================================
+//
+// Delimiter types that change what "equal" means while staying
+// equality_comparable_with the elements: each is implicitly constructible
+// from its character type, so take_before_view accepts it as its T. On
+// bounded contiguous ranges the delimiter search kernel uses their own
+// search (see detail::searchable_delimiter).
+
+// Tag for views::take_before(r, value, ascii_icase).
+struct ascii_icase_t {
+    explicit ascii_icase_t() = default;
+};
+
+inline constexpr ascii_icase_t ascii_icase{};
+
+// A character that compares equal to the same character in the other ASCII
+// case: 'a'..'z' match 'A'..'Z', every other value only itself (as with ==).
+// Byte ranges are scanned eight bytes per load, or with memchr for a
+// delimiter that is not a letter.
+template <class C>
+    requires std::integral<C> && (!std::same_as<C, bool>)
+class ascii_icase_char {
+    C value_ = C();
+
+    template <class U>
+    static constexpr U fold(U c) {
+        return c >= U('A') && c <= U('Z') ? static_cast<U>(c + ('a' - 'A')) : c;
+    }
+
+  public:
+    ascii_icase_char() = default;
+    constexpr ascii_icase_char(C c) noexcept : value_(c) {}
+
+    constexpr C value() const noexcept { return value_; }
+
+    friend constexpr bool operator==(const ascii_icase_char& x, const ascii_icase_char& y) noexcept {
+        return fold(x.value_) == fold(y.value_);
+    }
+
+    template <class E>
+        requires std::integral<E> && (!std::same_as<E, bool>)
+    friend constexpr bool operator==(const ascii_icase_char& x, E e) noexcept {
+        return fold(x.value_) == fold(e);
+    }
+
+    template <class E>
+        requires detail::byte_element<E> && detail::kernel_value<E, C>
+    friend const E* find_delimiter_n(const ascii_icase_char& d, const E* first, std::size_t n) {
+        const C lower = fold(d.value_);
+        if (lower < C('a') || lower > C('z')) {
+            return detail::find_value_n(first, n, d.value_);
+        }
+        const auto* p = reinterpret_cast<const unsigned char*>(first);
+        return first + detail::find_byte_icase(p, 0, n, static_cast<unsigned char>(lower));
+    }
+};
+
+// A character compared with Traits::eq, and searched for with Traits::find.
+// take_before_view deduces it as the delimiter type for basic_string_view
+// bases with traits other than std::char_traits.
+template <class C, class Traits = std::char_traits<C>>
+class traits_char {
+    C value_ = C();
+
+  public:
+    using traits_type = Traits;
+
+    traits_char() = default;
+    constexpr traits_char(C c) noexcept : value_(c) {}
+
+    constexpr C value() const noexcept { return value_; }
+
+    friend constexpr bool operator==(const traits_char& x, const traits_char& y) noexcept {
+        return Traits::eq(x.value_, y.value_);
+    }
+
+    friend const C* find_delimiter_n(const traits_char& d, const C* first, std::size_t n) {
+        const C* p = Traits::find(first, n, d.value_);
+        return p ? p : first + n;
+    }
+};
+
 // ============================================================================
 // take_before_view class template
 // ============================================================================
 
 template <std::ranges::view V, std::move_constructible T>
     requires std::ranges::input_range<V> && std::is_object_v<T> &&
-             std::indirect_binary_predicate<std::ranges::equal_to, std::ranges::iterator_t<V>, const T*>
+             detail::indirect_delimiter<std::ranges::iterator_t<V>, T>
 class take_before_view : public std::ranges::view_interface<take_before_view<V, T>> {
     template <bool>
     class sentinel; // exposition only
@@ -60,6 +229,8 @@ class take_before_view : public std::ranges::view_interface<take_before_view<V,
     V              base_ = V(); // exposition only
     movable_box<T> value_;      // exposition only
 
+    friend struct detail::view_access;
+
   public:
     take_before_view()
         requires std::default_initializable<V> && std::default_initializable<T>
@@ -86,7 +257,7 @@ class take_before_view : public std::ranges::view_interface<take_before_view<V,
 
     constexpr auto begin() const
         requires std::ranges::range<const V> &&
-                 std::indirect_binary_predicate<std::ranges::equal_to, std::ranges::iterator_t<const V>, const T*>
+                 detail::indirect_delimiter<std::ranges::iterator_t<const V>, T>
     {
         return std::ranges::begin(base_);
     }
@@ -102,13 +273,49 @@ class take_before_view : public std::ranges::view_interface<take_before_view<V,
 
     constexpr auto end() const
         requires std::ranges::range<const V> &&
-                 std::indirect_binary_predicate<std::ranges::equal_to, std::ranges::iterator_t<const V>, const T*>
+                 detail::indirect_delimiter<std::ranges::iterator_t<const V>, T>
     {
         if constexpr (tidy_obj<T>)
             return sentinel<true>(std::ranges::end(base_));
         else
             return sentinel<true>(std::ranges::end(base_), std::addressof(*value_));
     }
+
+    // An upper bound on the number of elements, for containers to reserve
+    // before materializing the view (P2846). The prefix is never longer
+    // than the base, so the base's size or own hint serves without a scan.
+    constexpr auto reserve_hint()
+        requires detail::approximately_sized_range<V>
+    {
+        return detail::reserve_hint(base_);
+    }
+
+    constexpr auto reserve_hint() const
+        requires detail::approximately_sized_range<const V>
+    {
+        return detail::reserve_hint(base_);
+    }
+
+    // The elements of the view as a std::span. The end is located once by the
+    // delimiter search kernel instead of by iterating against the sentinel.
+    constexpr auto to_span()
+        requires(!simple_view<V>) && std::ranges::contiguous_range<V>
+    {
+        if constexpr (tidy_obj<T>)
+            return detail::span_before(base_, T());
+        else
+            return detail::span_before(base_, *value_);
+    }
+
+    constexpr auto to_span() const
+        requires std::ranges::contiguous_range<const V> &&
+                 detail::indirect_delimiter<std::ranges::iterator_t<const V>, T>
+    {
+        if constexpr (tidy_obj<T>)
+            return detail::span_before(base_, T());
+        else
+            return detail::span_before(base_, *value_);
+    }
 };
 
 // ============================================================================
@@ -117,7 +324,7 @@ class take_before_view : public std::ranges::view_interface<take_before_view<V,
 
 template <std::ranges::view V, std::move_constructible T>
     requires std::ranges::input_range<V> && std::is_object_v<T> &&
-             std::indirect_binary_predicate<std::ranges::equal_to, std::ranges::iterator_t<V>, const T*>
+             detail::indirect_delimiter<std::ranges::iterator_t<V>, T>
 template <bool Const>
 class take_before_view<V, T>::sentinel {
     using Base = maybe_const<Const, V>; // exposition only
@@ -175,6 +382,293 @@ class take_before_view<V, T>::sentinel {
 template <class R, class T>
 take_before_view(R&&, T) -> take_before_view<std::ranges::views::all_t<R>, T>;
 
+template <class C, class Traits, class T>
+    requires(!std::same_as<Traits, std::char_traits<C>>) && std::convertible_to<T, C>
+take_before_view(std::basic_string_view<C, Traits>, T)
+    -> take_before_view<std::basic_string_view<C, Traits>, traits_char<C, Traits>>;
+
+namespace detail {
+
+// Read access to a view's base and delimiter for the fused algorithms in the
+// other headers, which need both without going through the sentinel.
+struct view_access {
+    template <class V, class T>
+    static constexpr const V& base(const take_before_view<V, T>& v) {
+        return v.base_;
+    }
+
+    template <class V, class T>
+    static constexpr decltype(auto) value(const take_before_view<V, T>& v) {
+        if constexpr (tidy_obj<T>) {
+            return T();
+        } else {
+            return static_cast<const T&>(*v.value_);
+        }
+    }
+};
+
+} // namespace detail
+
+// ============================================================================
+// take_before_code_point_view class template
+// ============================================================================
+
+namespace detail {
+
+// Code units of the UTF-8 (char, char8_t) and UTF-16 (char16_t) encodings.
+template <class C>
+concept utf_code_unit = std::same_as<C, char> || std::same_as<C, char8_t> || std::same_as<C, char16_t>;
+
+// The encoding of a code point as C code units. Surrogates and values past
+// U+10FFFF have no encoding; they are held with size 0 and occur nowhere.
+template <utf_code_unit C>
+struct encoded_code_point {
+    C            units[4] = {};
+    std::uint8_t size     = 0;
+
+    encoded_code_point() = default;
+
+    constexpr explicit encoded_code_point(char32_t c) {
+        const auto unit = [&](std::uint32_t u) { units[size++] = static_cast<C>(u); };
+        if ((c >= 0xD800 && c <= 0xDFFF) || c > 0x10FFFF) {
+            return;
+        }
+        if constexpr (sizeof(C) == 2) {
+            if (c < 0x10000) {
+                unit(c);
+            } else {
+                unit(0xD800 + ((c - 0x10000) >> 10));
+                unit(0xDC00 + ((c - 0x10000) & 0x3FF));
+            }
+        } else if (c < 0x80) {
+            unit(c);
+        } else if (c < 0x800) {
+            unit(0xC0 | (c >> 6));
+            unit(0x80 | (c & 0x3F));
+        } else if (c < 0x10000) {
+            unit(0xE0 | (c >> 12));
+            unit(0x80 | ((c >> 6) & 0x3F));
+            unit(0x80 | (c & 0x3F));
+        } else {
+            unit(0xF0 | (c >> 18));
+            unit(0x80 | ((c >> 12) & 0x3F));
+            unit(0x80 | ((c >> 6) & 0x3F));
+            unit(0x80 | (c & 0x3F));
+        }
+    }
+
+    // Whether the encoding occurs at x, which is not last.
+    template <class I, class S>
+    constexpr bool at(I x, const S& last) const {
+        if (size == 0 || !(units[0] == *x)) {
+            return false;
+        }
+        for (std::size_t k = 1; k < size; ++k) {
+            if (++x == last || !(units[k] == *x)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // The first occurrence in [first, last), or last. The first unit is
+    // located by the delimiter search kernel and the rest compared there.
+    // A lead unit is never a continuation unit (nor a high surrogate a low
+    // one), so in well-formed text every occurrence starts a code point.
+    template <class I, class S>
+    constexpr I find(I first, const S& last) const {
+        if (size == 0) {
+            return std::ranges::next(std::move(first), last);
+        }
+        for (;; ++first) {
+            first = detail::find_value(std::move(first), last, units[0]);
+            if (first == last || at(first, last)) {
+                return first;
+            }
+        }
+    }
+};
+
+template <class V, class T>
+concept code_point_search = std::ranges::forward_range<V> && utf_code_unit<std::ranges::range_value_t<V>> &&
+                            std::same_as<T, char32_t>;
+
+} // namespace detail
+
+// The elements of a range of UTF-8 or UTF-16 code units before the first
+// encoded occurrence of a code point, without decoding: the sentinel
+// compares the encoding at each position, to_span() searches for its first
+// unit with memchr on UTF-8 and verifies the rest. views::take_before
+// returns this view for a char32_t delimiter on such a range.
+template <std::ranges::view V>
+    requires std::ranges::forward_range<V> && detail::utf_code_unit<std::ranges::range_value_t<V>>
+class take_before_code_point_view : public std::ranges::view_interface<take_before_code_point_view<V>> {
+    using C = std::ranges::range_value_t<V>;
+
+    template <bool>
+    class sentinel;
+
+    V                             base_       = V();
+    char32_t                      code_point_ = 0;
+    detail::encoded_code_point<C> encoded_;
+
+  public:
+    take_before_code_point_view()
+        requires std::default_initializable<V>
+    = default;
+
+    constexpr explicit take_before_code_point_view(V base, char32_t c)
+        : base_(std::move(base)), code_point_(c), encoded_(c) {}
+
+    constexpr V base() const&
+        requires std::copy_constructible<V>
+    {
+        return base_;
+    }
+    constexpr V base() && { return std::move(base_); }
+
+    constexpr char32_t code_point() const noexcept { return code_point_; }
+
+    constexpr auto begin()
+        requires(!simple_view<V>)
+    {
+        return std::ranges::begin(base_);
+    }
+
+    constexpr auto begin() const
+        requires std::ranges::forward_range<const V>
+    {
+        return std::ranges::begin(base_);
+    }
+
+    constexpr auto end()
+        requires(!simple_view<V>)
+    {
+        return sentinel<false>(std::ranges::end(base_), encoded_);
+    }
+
+    constexpr auto end() const
+        requires std::ranges::forward_range<const V>
+    {
+        return sentinel<true>(std::ranges::end(base_), encoded_);
+    }
+
+    constexpr auto reserve_hint()
+        requires detail::approximately_sized_range<V>
+    {
+        return detail::reserve_hint(base_);
+    }
+
+    constexpr auto reserve_hint() const
+        requires detail::approximately_sized_range<const V>
+    {
+        return detail::reserve_hint(base_);
+    }
+
+    constexpr auto to_span()
+        requires(!simple_view<V>) && std::ranges::contiguous_range<V>
+    {
+        return span(base_, encoded_);
+    }
+
+    constexpr auto to_span() const
+        requires std::ranges::contiguous_range<const V>
+    {
+        return span(base_, encoded_);
+    }
+
+  private:
+    template <class R>
+    static constexpr auto span(R& r, const detail::encoded_code_point<C>& encoded) {
+        using E    = std::remove_reference_t<std::ranges::range_reference_t<R>>;
+        auto first = std::ranges::begin(r);
+        auto last  = encoded.find(first, std::ranges::end(r));
+        return std::span<E>(std::to_address(first), static_cast<std::size_t>(last - first));
+    }
+};
+
+template <std::ranges::view V>
+    requires std::ranges::forward_range<V> && detail::utf_code_unit<std::ranges::range_value_t<V>>
+template <bool Const>
+class take_before_code_point_view<V>::sentinel {
+    using Base = maybe_const<Const, V>;
+
+    std::ranges::sentinel_t<Base> end_ = std::ranges::sentinel_t<Base>();
+    detail::encoded_code_point<C> encoded_;
+
+    template <bool>
+    friend class sentinel;
+
+    constexpr sentinel(std::ranges::sentinel_t<Base> end, const detail::encoded_code_point<C>& encoded)
+        : end_(end), encoded_(encoded) {}
+
+    friend class take_before_code_point_view;
+
+  public:
+    sentinel() = default;
+
+    constexpr sentinel(sentinel<!Const> s)
+        requires Const && std::convertible_to<std::ranges::sentinel_t<V>, std::ranges::sentinel_t<Base>>
+        : end_(std::move(s.end_)), encoded_(s.encoded_) {}
+
+    constexpr std::ranges::sentinel_t<Base> base() const { return end_; }
+
+    friend constexpr bool operator==(const std::ranges::iterator_t<Base>& x, const sentinel& y) {
+        return y.end_ == x || y.encoded_.at(x, y.end_);
+    }
+
+    template <bool OtherConst = !Const>
+        requires std::sentinel_for<std::ranges::sentinel_t<Base>, std::ranges::iterator_t<maybe_const<OtherConst, V>>>
+    friend constexpr bool operator==(const std::ranges::iterator_t<maybe_const<OtherConst, V>>& x, const sentinel& y) {
+        return y.end_ == x || y.encoded_.at(x, y.end_);
+    }
+};
+
+template <class R>
+take_before_code_point_view(R&&, char32_t) -> take_before_code_point_view<std::ranges::views::all_t<R>>;
+
+// ============================================================================
+// take_before_span / take_before_sv
+// ============================================================================
+
+// Eager counterparts of views::take_before for contiguous inputs: locate the
+// delimiter once and return the prefix as a std::span, or for character
+// ranges as a std::basic_string_view, which are sized, common and accepted
+// by span- and string_view-taking APIs. An iterator argument is searched
+// without a bound, as views::take_before does.
+
+template <std::ranges::contiguous_range R, class T>
+    requires std::ranges::borrowed_range<R> &&
+             detail::indirect_delimiter<std::ranges::iterator_t<R>, T>
+constexpr auto take_before_span(R&& r, const T& value) {
+    return detail::span_before(r, value);
+}
+
+template <class I, class T>
+    requires std::contiguous_iterator<std::decay_t<I>> && (!std::ranges::range<std::remove_cvref_t<I>>) &&
+             detail::indirect_delimiter<std::decay_t<I>, T>
+constexpr auto take_before_span(I&& i, const T& value) {
+    auto r = std::ranges::subrange(std::decay_t<I>(i), std::unreachable_sentinel);
+    return detail::span_before(r, value);
+}
+
+template <std::ranges::contiguous_range R, class T>
+    requires std::ranges::borrowed_range<R> && detail::character<std::ranges::range_value_t<R>> &&
+             detail::indirect_delimiter<std::ranges::iterator_t<R>, T>
+constexpr auto take_before_sv(R&& r, const T& value) {
+    auto s = detail::span_before(r, value);
+    return std::basic_string_view<std::ranges::range_value_t<R>>(s.data(), s.size());
+}
+
+template <class I, class T>
+    requires std::contiguous_iterator<std::decay_t<I>> && (!std::ranges::range<std::remove_cvref_t<I>>) &&
+             detail::character<std::iter_value_t<std::decay_t<I>>> &&
+             detail::indirect_delimiter<std::decay_t<I>, T>
+constexpr auto take_before_sv(I&& i, const T& value) {
+    auto s = beman::take_before::take_before_span(std::forward<I>(i), value);
+    return std::basic_string_view<std::iter_value_t<std::decay_t<I>>>(s.data(), s.size());
+}
+
 } // namespace beman::take_before
 
 // ============================================================================
@@ -185,6 +679,9 @@ namespace std::ranges {
 template <class V, class T>
 constexpr bool enable_borrowed_range<beman::take_before::take_before_view<V, T>> =
     enable_borrowed_range<V> && beman::take_before::tidy_obj<T>;
+
+template <class V>
+constexpr bool enable_borrowed_range<beman::take_before::take_before_code_point_view<V>> = enable_borrowed_range<V>;
 } // namespace std::ranges
 
 // ============================================================================
@@ -195,6 +692,18 @@ namespace beman::take_before::views {
 
 namespace detail {
 
+// A take_before_code_point_view for a char32_t delimiter on a forward range
+// of UTF-8 or UTF-16 code units, a take_before_view otherwise.
+template <class R, class T>
+constexpr auto make_take_before(R&& r, T&& value) {
+    using V = std::ranges::views::all_t<R>;
+    if constexpr (beman::take_before::detail::code_point_search<V, std::remove_cvref_t<T>>) {
+        return beman::take_before::take_before_code_point_view(std::forward<R>(r), value);
+    } else {
+        return beman::take_before::take_before_view(std::forward<R>(r), std::forward<T>(value));
+    }
+}
+
 // Range adaptor closure for pipe operator (C++20 compatible implementation)
 template <class T>
 class take_before_closure {
@@ -206,7 +715,7 @@ class take_before_closure {
     template <std::ranges::viewable_range R>
         requires requires { beman::take_before::take_before_view(std::declval<R>(), std::declval<T>()); }
     constexpr auto operator()(R&& r) const {
-        return beman::take_before::take_before_view(std::forward<R>(r), value_);
+        return detail::make_take_before(std::forward<R>(r), value_);
     }
 
     // Pipe operator
@@ -224,7 +733,7 @@ struct take_before_fn {
     template <std::ranges::viewable_range R, typename T>
         requires requires { beman::take_before::take_before_view(std::declval<R>(), std::declval<T>()); }
     constexpr auto operator()(R&& r, T&& value) const {
-        return beman::take_before::take_before_view(std::forward<R>(r), std::forward<T>(value));
+        return detail::make_take_before(std::forward<R>(r), std::forward<T>(value));
     }
 
     // Overload 2: input_iterator (not range)
@@ -234,8 +743,7 @@ struct take_before_fn {
                                                  std::declval<T>());
         }
     constexpr auto operator()(I i, T&& value) const {
-        return beman::take_before::take_before_view(std::ranges::subrange(i, std::unreachable_sentinel),
-                                                    std::forward<T>(value));
+        return detail::make_take_before(std::ranges::subrange(i, std::unreachable_sentinel), std::forward<T>(value));
     }
 
     // Overload 3: single argument for pipe operator
@@ -243,6 +751,20 @@ struct take_before_fn {
     constexpr auto operator()(T&& value) const {
         return detail::take_before_closure<std::decay_t<T>>(std::forward<T>(value));
     }
+
+    // Overloads 4 and 5: ASCII case-insensitive delimiter, for a range or
+    // iterator and for the pipe operator
+    template <class R, class T>
+        requires requires(const take_before_fn& f) { f(std::declval<R>(), ascii_icase_char<T>()); }
+    constexpr auto operator()(R&& r, T value, ascii_icase_t) const {
+        return (*this)(std::forward<R>(r), ascii_icase_char<T>(value));
+    }
+
+    template <class T>
+        requires requires { ascii_icase_char<T>(); }
+    constexpr auto operator()(T value, ascii_icase_t) const {
+        return detail::take_before_closure<ascii_icase_char<T>>(ascii_icase_char<T>(value));
+    }
 };
 
 inline constexpr take_before_fn take_before;
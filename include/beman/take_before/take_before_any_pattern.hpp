@@ -0,0 +1,488 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_TAKE_BEFORE_ANY_PATTERN_HPP
+#define BEMAN_TAKE_BEFORE_TAKE_BEFORE_ANY_PATTERN_HPP
+
+#include <beman/take_before/detail/find.hpp>
+#include <beman/take_before/detail/swar.hpp>
+#include <beman/take_before/take_before.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace beman::take_before {
+
+// ============================================================================
+// basic_pattern_set class template
+// ============================================================================
+
+// Converts to a result with std::ranges::dangling as position, which keeps
+// the pattern index, for an rvalue range that does not borrow.
+template <class I>
+struct pattern_find_result {
+    [[no_unique_address]] I position; // start of the earliest occurrence, or the end of the input
+    std::size_t             pattern;  // index of the pattern found there, or npos
+
+    template <class I2>
+        requires std::convertible_to<const I&, I2>
+    constexpr operator pattern_find_result<I2>() const& {
+        return {position, pattern};
+    }
+
+    template <class I2>
+        requires std::convertible_to<I, I2>
+    constexpr operator pattern_find_result<I2>() && {
+        return {std::move(position), pattern};
+    }
+};
+
+// A set of byte-string patterns compiled into an Aho-Corasick automaton, for
+// finding the earliest occurrence of any of them in one pass. Compile it
+// once and share it: views::take_before_any_pattern refers to an lvalue set
+// and takes shared ownership only of a temporary one.
+//
+// The automaton is a complete DFA over byte classes (each byte that occurs in
+// some pattern is its own class, all other bytes share class 0), so a step
+// is one table load. Each state records the depth of the trie node it stands
+// for and the longest pattern ending there, which gives the earliest start
+// of a match ending at the current position; the scan goes on only while a
+// later match could still start as early. From the root state, contiguous
+// input is skipped to the next byte that starts a pattern: with memchr for a
+// single such byte, with eight-byte SWAR tests for up to four, and with a
+// table lookup per byte otherwise.
+template <class CharT = char>
+    requires detail::character<CharT> && (sizeof(CharT) == 1)
+class basic_pattern_set {
+    static constexpr std::uint32_t none       = std::uint32_t(-1);
+    static constexpr std::size_t   none_found = std::size_t(-1);
+
+    std::vector<std::basic_string<CharT>> patterns_;
+    std::array<std::uint16_t, 256>        class_{};
+    std::array<bool, 256>                 first_{};
+    std::vector<unsigned char>            first_bytes_;
+    std::size_t                           classes_ = 1;
+    std::vector<std::uint32_t>            next_;        // state * classes_ + class -> state
+    std::vector<std::uint32_t>            depth_;       // length of the prefix a state stands for
+    std::vector<std::uint32_t>            out_length_;  // longest pattern ending in a state, or 0
+    std::vector<std::uint32_t>            out_pattern_; // its index
+    std::size_t                           empty_ = none_found; // index of the first empty pattern
+
+    static unsigned char byte(CharT c) { return static_cast<unsigned char>(c); }
+
+    void compile() {
+        for (const auto& p : patterns_) {
+            for (CharT c : p) {
+                if (class_[byte(c)] == 0) {
+                    class_[byte(c)] = static_cast<std::uint16_t>(classes_++);
+                }
+            }
+            if (!p.empty() && !first_[byte(p.front())]) {
+                first_[byte(p.front())] = true;
+                first_bytes_.push_back(byte(p.front()));
+            }
+        }
+
+        // Trie.
+        const auto add_state = [&](std::uint32_t depth) {
+            next_.resize(next_.size() + classes_, none);
+            depth_.push_back(depth);
+            out_length_.push_back(0);
+            out_pattern_.push_back(0);
+            return static_cast<std::uint32_t>(depth_.size() - 1);
+        };
+        add_state(0);
+        for (std::size_t k = 0; k < patterns_.size(); ++k) {
+            std::uint32_t s = 0;
+            for (CharT c : patterns_[k]) {
+                const std::size_t slot = s * classes_ + class_[byte(c)];
+                if (next_[slot] == none) {
+                    const std::uint32_t t = add_state(depth_[s] + 1);
+                    next_[slot]           = t;
+                }
+                s = next_[slot];
+            }
+            if (patterns_[k].empty()) {
+                empty_ = std::min(empty_, k);
+            } else if (out_length_[s] == 0) {
+                out_length_[s]  = depth_[s];
+                out_pattern_[s] = static_cast<std::uint32_t>(k);
+            }
+        }
+
+        // Failure links, folded into the transition table breadth first.
+        std::vector<std::uint32_t> fail(depth_.size(), 0);
+        std::vector<std::uint32_t> queue;
+        for (std::size_t c = 0; c < classes_; ++c) {
+            auto& t = next_[c];
+            if (t == none) {
+                t = 0;
+            } else {
+                queue.push_back(t);
+            }
+        }
+        for (std::size_t q = 0; q < queue.size(); ++q) {
+            const std::uint32_t s = queue[q];
+            const std::uint32_t f = fail[s];
+            if (out_length_[s] == 0 && out_length_[f] != 0) {
+                out_length_[s]  = out_length_[f];
+                out_pattern_[s] = out_pattern_[f];
+            }
+            for (std::size_t c = 0; c < classes_; ++c) {
+                auto& t = next_[s * classes_ + c];
+                if (t == none) {
+                    t = next_[f * classes_ + c];
+                } else {
+                    fail[t] = next_[f * classes_ + c];
+                    queue.push_back(t);
+                }
+            }
+        }
+    }
+
+    // Scan state shared by the contiguous and the iterator paths.
+    struct scanner {
+        const basic_pattern_set& set;
+        std::uint32_t            state   = 0;
+        std::size_t              best    = none_found;
+        std::size_t              pattern = none_found;
+
+        // Consumes the byte at offset j; returns true once no match can
+        // start at or before the best one found so far. A match that ends
+        // later at the same start is longer, so it replaces the best one.
+        bool feed(unsigned char b, std::size_t j) {
+            state = set.next_[state * set.classes_ + set.class_[b]];
+            if (const std::uint32_t n = set.out_length_[state]; n != 0 && (best == none_found || j + 1 - n <= best)) {
+                best    = j + 1 - n;
+                pattern = set.out_pattern_[state];
+            }
+            return best != none_found && j + 1 - set.depth_[state] > best;
+        }
+    };
+
+    std::pair<std::size_t, std::size_t> find_bytes(const unsigned char* p, std::size_t n) const {
+        scanner s{*this};
+        for (std::size_t i = 0; i < n; ++i) {
+            if (s.state == 0 && s.best == none_found) {
+                i = detail::find_any_byte(p, i, n, first_bytes_.data(), first_bytes_.size(), first_);
+                if (i == n) {
+                    break;
+                }
+            }
+            if (s.feed(p[i], i)) {
+                break;
+            }
+        }
+        return {s.best, s.pattern};
+    }
+
+  public:
+    static constexpr std::size_t npos = none_found;
+
+    basic_pattern_set() { compile(); }
+
+    basic_pattern_set(std::initializer_list<std::basic_string_view<CharT>> patterns)
+        : patterns_(patterns.begin(), patterns.end()) {
+        compile();
+    }
+
+    template <std::ranges::input_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, std::basic_string_view<CharT>>
+    explicit basic_pattern_set(R&& patterns) {
+        for (auto&& p : patterns) {
+            patterns_.emplace_back(std::basic_string_view<CharT>(p));
+        }
+        compile();
+    }
+
+    std::size_t size() const noexcept { return patterns_.size(); }
+
+    std::basic_string_view<CharT> operator[](std::size_t i) const { return patterns_[i]; }
+
+    // Number of automaton states; the transition table has this many rows.
+    std::size_t states() const noexcept { return depth_.size(); }
+
+    // The earliest occurrence of any pattern in [first, last); among
+    // patterns occurring at the same position, the longest.
+    template <std::forward_iterator I, std::sentinel_for<I> S>
+        requires detail::byte_element<std::remove_cv_t<std::iter_value_t<I>>>
+    pattern_find_result<I> find(I first, S last) const {
+        if (empty_ != npos) {
+            return {std::move(first), empty_};
+        }
+        std::pair<std::size_t, std::size_t> found;
+        if constexpr (std::contiguous_iterator<I> && std::sized_sentinel_for<S, I>) {
+            found = find_bytes(reinterpret_cast<const unsigned char*>(std::to_address(first)),
+                               static_cast<std::size_t>(last - first));
+        } else {
+            scanner s{*this};
+            I       it = first;
+            for (std::size_t j = 0; !(it == last); ++it, ++j) {
+                if (s.feed(detail::to_byte(static_cast<std::remove_cv_t<std::iter_value_t<I>>>(*it)), j)) {
+                    break;
+                }
+            }
+            if (s.best == npos) {
+                return {std::move(it), npos};
+            }
+            found = {s.best, s.pattern};
+        }
+        if (found.first == npos) {
+            return {std::ranges::next(std::move(first), last), npos};
+        }
+        return {std::ranges::next(std::move(first), static_cast<std::iter_difference_t<I>>(found.first)),
+                found.second};
+    }
+
+    template <std::ranges::forward_range R>
+        requires detail::byte_element<std::remove_cv_t<std::ranges::range_value_t<R>>>
+    pattern_find_result<std::ranges::borrowed_iterator_t<R>> find(R&& r) const {
+        return find(std::ranges::begin(r), std::ranges::end(r));
+    }
+};
+
+using pattern_set   = basic_pattern_set<char>;
+using u8pattern_set = basic_pattern_set<char8_t>;
+
+// ============================================================================
+// take_before_any_pattern_view class template
+// ============================================================================
+
+// The elements of V before the earliest occurrence of any pattern of a
+// basic_pattern_set. A set passed as an lvalue is held by reference and must
+// outlive the view; a set passed as an rvalue (including a braced list of
+// patterns given to views::take_before_any_pattern) is moved to the heap and
+// shared by the copies of the view, which keeps copying O(1). The end is
+// located by one automaton scan on the first call to begin() or end() and
+// cached, so the view has the base's own iterators and is common, and
+// contiguous when the base is. As with filter_view, only non-const
+// iteration is provided: a const view is not a range.
+template <std::ranges::view V, class CharT>
+    requires std::ranges::forward_range<V> && detail::byte_element<std::remove_cv_t<std::ranges::range_value_t<V>>>
+class take_before_any_pattern_view : public std::ranges::view_interface<take_before_any_pattern_view<V, CharT>> {
+    V                                                         base_     = V();
+    const basic_pattern_set<CharT>*                           patterns_ = nullptr;
+    std::shared_ptr<const basic_pattern_set<CharT>>           owned_; // set to a set passed as an rvalue
+    detail::non_propagating_cache<std::ranges::iterator_t<V>> end_;
+
+  public:
+    take_before_any_pattern_view()
+        requires std::default_initializable<V>
+    = default;
+
+    constexpr take_before_any_pattern_view(V base, const basic_pattern_set<CharT>& patterns)
+        : base_(std::move(base)), patterns_(std::addressof(patterns)) {}
+
+    take_before_any_pattern_view(V base, basic_pattern_set<CharT>&& patterns)
+        : take_before_any_pattern_view(std::move(base),
+                                       std::make_shared<const basic_pattern_set<CharT>>(std::move(patterns))) {}
+
+    take_before_any_pattern_view(V base, std::shared_ptr<const basic_pattern_set<CharT>> patterns)
+        : base_(std::move(base)), patterns_(patterns.get()), owned_(std::move(patterns)) {}
+
+    constexpr V base() const&
+        requires std::copy_constructible<V>
+    {
+        return base_;
+    }
+    constexpr V base() && { return std::move(base_); }
+
+    constexpr const basic_pattern_set<CharT>& patterns() const { return *patterns_; }
+
+    constexpr std::ranges::iterator_t<V> begin() {
+        auto first = std::ranges::begin(base_);
+        if (!end_) {
+            end_.emplace(patterns_->find(first, std::ranges::end(base_)).position);
+        }
+        return first;
+    }
+
+    constexpr std::ranges::iterator_t<V> end() {
+        if (!end_) {
+            begin();
+        }
+        return *end_;
+    }
+
+    constexpr auto reserve_hint()
+        requires detail::approximately_sized_range<V>
+    {
+        return detail::reserve_hint(base_);
+    }
+};
+
+template <class R, class CharT>
+take_before_any_pattern_view(R&&, const basic_pattern_set<CharT>&)
+    -> take_before_any_pattern_view<std::ranges::views::all_t<R>, CharT>;
+
+template <class R, class CharT>
+take_before_any_pattern_view(R&&, basic_pattern_set<CharT>&&)
+    -> take_before_any_pattern_view<std::ranges::views::all_t<R>, CharT>;
+
+template <class R, class CharT>
+take_before_any_pattern_view(R&&, std::shared_ptr<const basic_pattern_set<CharT>>)
+    -> take_before_any_pattern_view<std::ranges::views::all_t<R>, CharT>;
+
+} // namespace beman::take_before
+
+// ============================================================================
+// enable_borrowed_range specialization
+// ============================================================================
+
+// The view's iterators are its base's, so it borrows whenever the base does.
+namespace std::ranges {
+template <class V, class CharT>
+constexpr bool enable_borrowed_range<beman::take_before::take_before_any_pattern_view<V, CharT>> =
+    enable_borrowed_range<V>;
+} // namespace std::ranges
+
+// ============================================================================
+// views::take_before_any_pattern adaptor
+// ============================================================================
+
+namespace beman::take_before::views {
+
+namespace detail {
+
+// Refers to an lvalue set, or shares ownership of one given as an rvalue.
+template <class CharT>
+class take_before_any_pattern_closure {
+    const basic_pattern_set<CharT>*                 patterns_;
+    std::shared_ptr<const basic_pattern_set<CharT>> owned_;
+
+    template <class R>
+    constexpr auto make(R&& r) const {
+        if (owned_) {
+            return beman::take_before::take_before_any_pattern_view(std::forward<R>(r), owned_);
+        }
+        return beman::take_before::take_before_any_pattern_view(std::forward<R>(r), *patterns_);
+    }
+
+  public:
+    constexpr explicit take_before_any_pattern_closure(const basic_pattern_set<CharT>& patterns)
+        : patterns_(std::addressof(patterns)) {}
+
+    explicit take_before_any_pattern_closure(basic_pattern_set<CharT>&& patterns)
+        : owned_(std::make_shared<const basic_pattern_set<CharT>>(std::move(patterns))) {
+        patterns_ = owned_.get();
+    }
+
+    template <std::ranges::viewable_range R>
+        requires requires {
+            beman::take_before::take_before_any_pattern_view(std::declval<R>(),
+                                                             std::declval<const basic_pattern_set<CharT>&>());
+        }
+    constexpr auto operator()(R&& r) const {
+        return make(std::forward<R>(r));
+    }
+
+    template <std::ranges::viewable_range R>
+        requires requires {
+            beman::take_before::take_before_any_pattern_view(std::declval<R>(),
+                                                             std::declval<const basic_pattern_set<CharT>&>());
+        }
+    friend constexpr auto operator|(R&& r, const take_before_any_pattern_closure& self) {
+        return self(std::forward<R>(r));
+    }
+};
+
+} // namespace detail
+
+struct take_before_any_pattern_fn {
+    template <std::ranges::viewable_range R, class CharT>
+        requires requires {
+            beman::take_before::take_before_any_pattern_view(std::declval<R>(),
+                                                             std::declval<const basic_pattern_set<CharT>&>());
+        }
+    constexpr auto operator()(R&& r, const basic_pattern_set<CharT>& patterns) const {
+        return beman::take_before::take_before_any_pattern_view(std::forward<R>(r), patterns);
+    }
+
+    // A temporary set, or a braced list of patterns, is owned by the view.
+    template <std::ranges::viewable_range R, class CharT>
+        requires requires {
+            beman::take_before::take_before_any_pattern_view(std::declval<R>(),
+                                                             std::declval<basic_pattern_set<CharT>>());
+        }
+    auto operator()(R&& r, basic_pattern_set<CharT>&& patterns) const {
+        return beman::take_before::take_before_any_pattern_view(std::forward<R>(r), std::move(patterns));
+    }
+
+    // A braced list of patterns deduces no CharT, so it is a pattern_set.
+    template <std::ranges::viewable_range R>
+        requires requires {
+            beman::take_before::take_before_any_pattern_view(std::declval<R>(), std::declval<pattern_set>());
+        }
+    auto operator()(R&& r, pattern_set&& patterns) const {
+        return beman::take_before::take_before_any_pattern_view(std::forward<R>(r), std::move(patterns));
+    }
+
+    // Unbounded search from an iterator; taken by forwarding reference so
+    // that arrays such as string literals bind to the range overload.
+    template <class I, class CharT>
+        requires std::forward_iterator<std::decay_t<I>> && (!std::ranges::range<std::remove_cvref_t<I>>) && requires {
+            beman::take_before::take_before_any_pattern_view(
+                std::ranges::subrange(std::declval<std::decay_t<I>>(), std::unreachable_sentinel),
+                std::declval<const basic_pattern_set<CharT>&>());
+        }
+    constexpr auto operator()(I&& i, const basic_pattern_set<CharT>& patterns) const {
+        return beman::take_before::take_before_any_pattern_view(
+            std::ranges::subrange(std::decay_t<I>(std::forward<I>(i)), std::unreachable_sentinel), patterns);
+    }
+
+    template <class I, class CharT>
+        requires std::forward_iterator<std::decay_t<I>> && (!std::ranges::range<std::remove_cvref_t<I>>) && requires {
+            beman::take_before::take_before_any_pattern_view(
+                std::ranges::subrange(std::declval<std::decay_t<I>>(), std::unreachable_sentinel),
+                std::declval<basic_pattern_set<CharT>>());
+        }
+    auto operator()(I&& i, basic_pattern_set<CharT>&& patterns) const {
+        return beman::take_before::take_before_any_pattern_view(
+            std::ranges::subrange(std::decay_t<I>(std::forward<I>(i)), std::unreachable_sentinel),
+            std::move(patterns));
+    }
+
+    template <class I>
+        requires std::forward_iterator<std::decay_t<I>> && (!std::ranges::range<std::remove_cvref_t<I>>) && requires {
+            beman::take_before::take_before_any_pattern_view(
+                std::ranges::subrange(std::declval<std::decay_t<I>>(), std::unreachable_sentinel),
+                std::declval<pattern_set>());
+        }
+    auto operator()(I&& i, pattern_set&& patterns) const {
+        return beman::take_before::take_before_any_pattern_view(
+            std::ranges::subrange(std::decay_t<I>(std::forward<I>(i)), std::unreachable_sentinel),
+            std::move(patterns));
+    }
+
+    template <class CharT>
+    constexpr auto operator()(const basic_pattern_set<CharT>& patterns) const {
+        return detail::take_before_any_pattern_closure<CharT>(patterns);
+    }
+
+    template <class CharT>
+    auto operator()(basic_pattern_set<CharT>&& patterns) const {
+        return detail::take_before_any_pattern_closure<CharT>(std::move(patterns));
+    }
+
+    auto operator()(pattern_set&& patterns) const {
+        return detail::take_before_any_pattern_closure<char>(std::move(patterns));
+    }
+};
+
+inline constexpr take_before_any_pattern_fn take_before_any_pattern;
+
+} // namespace beman::take_before::views
+
+#endif // BEMAN_TAKE_BEFORE_TAKE_BEFORE_ANY_PATTERN_HPP
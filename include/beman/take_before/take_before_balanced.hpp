@@ -0,0 +1,219 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_TAKE_BEFORE_BALANCED_HPP
+#define BEMAN_TAKE_BEFORE_TAKE_BEFORE_BALANCED_HPP
+
+#include <beman/take_before/detail/find.hpp>
+#include <beman/take_before/detail/stateful_view.hpp>
+#include <beman/take_before/detail/swar.hpp>
+#include <beman/take_before/take_before.hpp>
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace beman::take_before {
+
+namespace detail {
+
+// The first element equal to close that is not matched by an earlier element
+// equal to open; last if there is none. An element equal to both counts as
+// close.
+//
+// Bounded contiguous byte ranges skip eight bytes per load while none of
+// them is open or close, and only the brackets themselves go through the
+// depth counter, so text between brackets costs one word test per eight
+// bytes. Other ranges count depth one element at a time.
+template <class I, class S, class T>
+constexpr I find_balanced(I first, const S& last, const T& open, const T& close) {
+    if constexpr (std::contiguous_iterator<I> && std::sized_sentinel_for<S, I> &&
+                  byte_element<std::remove_cv_t<std::iter_value_t<I>>> &&
+                  kernel_value<std::remove_cv_t<std::iter_value_t<I>>, T>) {
+        using E = std::remove_cv_t<std::iter_value_t<I>>;
+        if (!std::is_constant_evaluated() && representable_as<E>(open) && representable_as<E>(close)) {
+            const auto* p = reinterpret_cast<const unsigned char*>(std::to_address(first));
+            const auto  n = static_cast<std::size_t>(last - first);
+            const auto  o = to_byte(static_cast<E>(open));
+            const auto  c = to_byte(static_cast<E>(close));
+
+            std::size_t depth = 0;
+            for (std::size_t i = 0;; ++i) {
+                for (; i + 8 <= n; i += 8) {
+                    const std::uint64_t w = load_le(p + i);
+                    if (const std::uint64_t m = has_byte(w, o) | has_byte(w, c)) {
+                        i += static_cast<std::size_t>(std::countr_zero(m) / 8);
+                        break;
+                    }
+                }
+                if (i == n) {
+                    return first + static_cast<std::iter_difference_t<I>>(n);
+                }
+                if (p[i] == c) {
+                    if (depth == 0) {
+                        return first + static_cast<std::iter_difference_t<I>>(i);
+                    }
+                    --depth;
+                } else if (p[i] == o) {
+                    ++depth;
+                }
+            }
+        }
+    }
+    std::size_t depth = 0;
+    for (; !(first == last); ++first) {
+        if (close == *first) {
+            if (depth == 0) {
+                break;
+            }
+            --depth;
+        } else if (open == *first) {
+            ++depth;
+        }
+    }
+    return first;
+}
+
+// The state machine of take_before_balanced_view over (open, close).
+struct balanced_scan {
+    class state {
+        std::size_t depth_ = 0;
+
+        friend struct balanced_scan;
+
+      public:
+        // Nesting depth of the element the iterator points at.
+        constexpr std::size_t depth() const noexcept { return depth_; }
+    };
+
+    template <class T, class E>
+    static constexpr void advance(state& s, const T& open, const T& close, const E& e) {
+        if (close == e) {
+            --s.depth_;
+        } else if (open == e) {
+            ++s.depth_;
+        }
+    }
+
+    template <class T, class E>
+    static constexpr bool stops(const state& s, const T&, const T& close, const E& e) {
+        return s.depth_ == 0 && close == e;
+    }
+
+    template <class I, class S, class T>
+    static constexpr I find(I first, const S& last, const T& open, const T& close) {
+        return find_balanced(std::move(first), last, open, close);
+    }
+};
+
+} // namespace detail
+
+// ============================================================================
+// take_before_balanced_view class template
+// ============================================================================
+
+// The elements of V before the first close element at nesting depth zero:
+// given the text after an opening bracket, the bracket's contents. Each open
+// element enters a level and each close element inside one leaves it, so
+// nested pairs are part of the view.
+//
+// The iterator carries the current depth(), so the view is at most forward.
+// to_span() locates the end of a contiguous base with detail::find_balanced.
+template <std::ranges::view V, std::move_constructible T>
+    requires std::ranges::input_range<V> && std::is_object_v<T> &&
+             detail::indirect_delimiter<std::ranges::iterator_t<V>, T>
+class take_before_balanced_view
+    : public detail::stateful_take_before_view<take_before_balanced_view<V, T>, detail::balanced_scan, V, T> {
+    using base_type = detail::stateful_take_before_view<take_before_balanced_view<V, T>, detail::balanced_scan, V, T>;
+
+  public:
+    using base_type::base_type;
+
+    constexpr const T& open() const { return this->first_value(); }
+    constexpr const T& close() const { return this->second_value(); }
+};
+
+template <class R, class T>
+take_before_balanced_view(R&&, T, T) -> take_before_balanced_view<std::ranges::views::all_t<R>, T>;
+
+} // namespace beman::take_before
+
+// ============================================================================
+// views::take_before_balanced adaptor
+// ============================================================================
+
+namespace beman::take_before::views {
+
+namespace detail {
+
+template <class T>
+class take_before_balanced_closure {
+    T open_;
+    T close_;
+
+  public:
+    constexpr take_before_balanced_closure(T open, T close) : open_(std::move(open)), close_(std::move(close)) {}
+
+    template <std::ranges::viewable_range R>
+        requires requires {
+            beman::take_before::take_before_balanced_view(std::declval<R>(), std::declval<T>(), std::declval<T>());
+        }
+    constexpr auto operator()(R&& r) const {
+        return beman::take_before::take_before_balanced_view(std::forward<R>(r), open_, close_);
+    }
+
+    template <std::ranges::viewable_range R>
+        requires requires {
+            beman::take_before::take_before_balanced_view(std::declval<R>(), std::declval<T>(), std::declval<T>());
+        }
+    friend constexpr auto operator|(R&& r, const take_before_balanced_closure& self) {
+        return self(std::forward<R>(r));
+    }
+};
+
+} // namespace detail
+
+struct take_before_balanced_fn {
+    template <std::ranges::viewable_range R, class T>
+        requires requires {
+            beman::take_before::take_before_balanced_view(
+                std::declval<R>(), std::declval<std::decay_t<T>>(), std::declval<std::decay_t<T>>());
+        }
+    constexpr auto operator()(R&& r, T&& open, std::type_identity_t<std::decay_t<T>> close) const {
+        return beman::take_before::take_before_balanced_view(
+            std::forward<R>(r), std::decay_t<T>(std::forward<T>(open)), std::move(close));
+    }
+
+    // Unbounded search from an iterator; taken by forwarding reference so
+    // that arrays such as string literals bind to the range overload.
+    template <class I, class T>
+        requires std::input_iterator<std::decay_t<I>> && (!std::ranges::range<std::remove_cvref_t<I>>) && requires {
+            beman::take_before::take_before_balanced_view(
+                std::ranges::subrange(std::declval<std::decay_t<I>>(), std::unreachable_sentinel),
+                std::declval<std::decay_t<T>>(),
+                std::declval<std::decay_t<T>>());
+        }
+    constexpr auto operator()(I&& i, T&& open, std::type_identity_t<std::decay_t<T>> close) const {
+        return beman::take_before::take_before_balanced_view(
+            std::ranges::subrange(std::decay_t<I>(std::forward<I>(i)), std::unreachable_sentinel),
+            std::decay_t<T>(std::forward<T>(open)),
+            std::move(close));
+    }
+
+    template <class T>
+    constexpr auto operator()(T&& open, std::type_identity_t<std::decay_t<T>> close) const {
+        return detail::take_before_balanced_closure<std::decay_t<T>>(std::forward<T>(open), std::move(close));
+    }
+};
+
+inline constexpr take_before_balanced_fn take_before_balanced;
+
+} // namespace beman::take_before::views
+
+#endif // BEMAN_TAKE_BEFORE_TAKE_BEFORE_BALANCED_HPP
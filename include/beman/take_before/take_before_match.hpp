@@ -0,0 +1,733 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_TAKE_BEFORE_MATCH_HPP
+#define BEMAN_TAKE_BEFORE_TAKE_BEFORE_MATCH_HPP
+
+#include <beman/take_before/detail/find.hpp>
+#include <beman/take_before/detail/swar.hpp>
+#include <beman/take_before/take_before.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace beman::take_before {
+
+// A string literal usable as a template argument.
+template <std::size_t N>
+struct fixed_string {
+    char data[N]{};
+
+    constexpr fixed_string(const char (&s)[N]) {
+        for (std::size_t i = 0; i < N; ++i) {
+            data[i] = s[i];
+        }
+    }
+
+    constexpr std::string_view view() const { return std::string_view(data, N - 1); }
+};
+
+namespace detail::regex {
+
+// ============================================================================
+// Compile-time regular expressions
+// ============================================================================
+//
+// The pattern is parsed into a Thompson NFA, the bytes are partitioned into
+// classes that no transition tells apart, and the subset construction turns
+// the NFA into a DFA over those classes. All of it runs during constant
+// evaluation; a malformed pattern is a compile error. The syntax is a small
+// ECMAScript-like subset over bytes:
+//
+//   x          the byte x, unless it is one of  \ . [ ] ( ) | * + ?
+//   \x         x itself, or one of \n \r \t \f \v \0 \xHH, or a class
+//              \d \D \s \S \w \W
+//   .          any byte but \n
+//   [...]      a bracket expression: bytes, ranges a-z, the escapes above;
+//              [^...] is its complement
+//   (...)      grouping;  a|b  alternation;  a* a+ a?  repetition
+
+struct byte_set {
+    std::uint64_t bits[4]{};
+
+    constexpr void add(unsigned b) { bits[b >> 6] |= std::uint64_t(1) << (b & 63); }
+
+    constexpr void add_range(unsigned lo, unsigned hi) {
+        for (unsigned b = lo; b <= hi; ++b) {
+            add(b);
+        }
+    }
+
+    constexpr void add(const byte_set& other) {
+        for (int k = 0; k < 4; ++k) {
+            bits[k] |= other.bits[k];
+        }
+    }
+
+    constexpr void invert() {
+        for (auto& w : bits) {
+            w = ~w;
+        }
+    }
+
+    constexpr bool contains(unsigned b) const { return (bits[b >> 6] >> (b & 63)) & 1; }
+};
+
+inline constexpr std::size_t no_state = static_cast<std::size_t>(-1);
+
+struct nfa_state {
+    byte_set    set;
+    bool        consumes = false; // a byte in set moves to next
+    std::size_t next     = no_state;
+    std::size_t eps[2]   = {no_state, no_state};
+};
+
+struct fragment {
+    std::size_t start;
+    std::size_t end; // has no outgoing edges until the enclosing construct adds them
+};
+
+class parser {
+    std::string_view pattern_;
+    std::size_t      i_ = 0;
+
+    constexpr bool at(char c) const { return i_ < pattern_.size() && pattern_[i_] == c; }
+
+    constexpr std::size_t add() {
+        states.push_back(nfa_state{});
+        return states.size() - 1;
+    }
+
+    constexpr fragment consume(const byte_set& set) {
+        const std::size_t s = add();
+        const std::size_t e = add();
+        states[s].set       = set;
+        states[s].consumes  = true;
+        states[s].next      = e;
+        return {s, e};
+    }
+
+    static constexpr unsigned hex(char c) {
+        if (c >= '0' && c <= '9') {
+            return static_cast<unsigned>(c - '0');
+        }
+        if (c >= 'a' && c <= 'f') {
+            return static_cast<unsigned>(c - 'a' + 10);
+        }
+        if (c >= 'A' && c <= 'F') {
+            return static_cast<unsigned>(c - 'A' + 10);
+        }
+        throw std::invalid_argument("invalid \\x escape in pattern");
+    }
+
+    // After a backslash: the set it denotes, and whether that is one byte.
+    constexpr std::pair<byte_set, bool> escape() {
+        if (i_ == pattern_.size()) {
+            throw std::invalid_argument("pattern ends with a backslash");
+        }
+        const char c = pattern_[i_++];
+        byte_set   set;
+        switch (c) {
+        case 'n':
+            set.add('\n');
+            return {set, true};
+        case 'r':
+            set.add('\r');
+            return {set, true};
+        case 't':
+            set.add('\t');
+            return {set, true};
+        case 'f':
+            set.add('\f');
+            return {set, true};
+        case 'v':
+            set.add('\v');
+            return {set, true};
+        case '0':
+            set.add(0);
+            return {set, true};
+        case 'x': {
+            if (pattern_.size() - i_ < 2) {
+                throw std::invalid_argument("invalid \\x escape in pattern");
+            }
+            const unsigned hi = hex(pattern_[i_++]);
+            set.add(hi * 16 + hex(pattern_[i_++]));
+            return {set, true};
+        }
+        case 'd':
+        case 'D':
+            set.add_range('0', '9');
+            break;
+        case 's':
+        case 'S':
+            for (char w : {' ', '\t', '\n', '\r', '\f', '\v'}) {
+                set.add(static_cast<unsigned char>(w));
+            }
+            break;
+        case 'w':
+        case 'W':
+            set.add_range('a', 'z');
+            set.add_range('A', 'Z');
+            set.add_range('0', '9');
+            set.add('_');
+            break;
+        default:
+            set.add(static_cast<unsigned char>(c));
+            return {set, true};
+        }
+        if (c == 'D' || c == 'S' || c == 'W') {
+            set.invert();
+        }
+        return {set, false};
+    }
+
+    constexpr byte_set bracket() {
+        byte_set set;
+        const bool negate = at('^');
+        if (negate) {
+            ++i_;
+        }
+        for (bool first = true; first || !at(']'); first = false) {
+            if (i_ == pattern_.size()) {
+                throw std::invalid_argument("unterminated [ in pattern");
+            }
+            std::pair<byte_set, bool> item;
+            unsigned                  lo = static_cast<unsigned char>(pattern_[i_]);
+            if (pattern_[i_++] == '\\') {
+                item = escape();
+                for (lo = 0; item.second && !item.first.contains(lo); ++lo) {
+                }
+            } else {
+                item.first.add(lo);
+                item.second = true;
+            }
+            if (item.second && at('-') && i_ + 1 < pattern_.size() && pattern_[i_ + 1] != ']') {
+                ++i_;
+                unsigned hi = static_cast<unsigned char>(pattern_[i_]);
+                if (pattern_[i_++] == '\\') {
+                    const auto end = escape();
+                    if (!end.second) {
+                        throw std::invalid_argument("class escape as the end of a range in pattern");
+                    }
+                    for (hi = 0; !end.first.contains(hi); ++hi) {
+                    }
+                }
+                if (hi < lo) {
+                    throw std::invalid_argument("reversed range in pattern");
+                }
+                set.add_range(lo, hi);
+            } else {
+                set.add(item.first);
+            }
+        }
+        ++i_;
+        if (negate) {
+            set.invert();
+        }
+        return set;
+    }
+
+    constexpr fragment atom() {
+        const char c = pattern_[i_++];
+        switch (c) {
+        case '(': {
+            const fragment f = alternation();
+            if (!at(')')) {
+                throw std::invalid_argument("unterminated ( in pattern");
+            }
+            ++i_;
+            return f;
+        }
+        case '[':
+            return consume(bracket());
+        case '.': {
+            byte_set set;
+            set.add('\n');
+            set.invert();
+            return consume(set);
+        }
+        case '\\':
+            return consume(escape().first);
+        case ')':
+        case ']':
+        case '*':
+        case '+':
+        case '?':
+            throw std::invalid_argument("unexpected character in pattern");
+        default: {
+            byte_set set;
+            set.add(static_cast<unsigned char>(c));
+            return consume(set);
+        }
+        }
+    }
+
+    constexpr fragment repetition() {
+        fragment f = atom();
+        while (at('*') || at('+') || at('?')) {
+            const char        op = pattern_[i_++];
+            const std::size_t s  = add();
+            const std::size_t e  = add();
+            if (op == '*') {
+                states[s].eps[0]     = f.start;
+                states[s].eps[1]     = e;
+                states[f.end].eps[0] = f.start;
+                states[f.end].eps[1] = e;
+            } else if (op == '+') {
+                states[s].eps[0]     = f.start;
+                states[f.end].eps[0] = f.start;
+                states[f.end].eps[1] = e;
+            } else {
+                states[s].eps[0]     = f.start;
+                states[s].eps[1]     = e;
+                states[f.end].eps[0] = e;
+            }
+            f = {s, e};
+        }
+        return f;
+    }
+
+    constexpr fragment concatenation() {
+        const std::size_t s = add();
+        fragment          f{s, s};
+        while (i_ < pattern_.size() && !at('|') && !at(')')) {
+            const fragment g     = repetition();
+            states[f.end].eps[0] = g.start;
+            f.end                = g.end;
+        }
+        return f;
+    }
+
+    constexpr fragment alternation() {
+        fragment f = concatenation();
+        while (at('|')) {
+            ++i_;
+            const fragment    g  = concatenation();
+            const std::size_t s  = add();
+            const std::size_t e  = add();
+            states[s].eps[0]     = f.start;
+            states[s].eps[1]     = g.start;
+            states[f.end].eps[0] = e;
+            states[g.end].eps[0] = e;
+            f                    = {s, e};
+        }
+        return f;
+    }
+
+  public:
+    std::vector<nfa_state> states;
+
+    constexpr explicit parser(std::string_view pattern) : pattern_(pattern) {}
+
+    constexpr fragment parse() {
+        const fragment f = alternation();
+        if (i_ != pattern_.size()) {
+            throw std::invalid_argument("unmatched ) in pattern");
+        }
+        return f;
+    }
+};
+
+// The largest table the DFA of one pattern may fill: it is built once into
+// arrays of this size during constant evaluation, and its entries are then
+// copied into tables of the exact size.
+inline constexpr std::size_t max_table = std::size_t(1) << 14;
+
+// The DFA of the unanchored search, fed every byte from the start of the
+// input. A run of the NFA from each position where a match may still start
+// forms a group, and a DFA state is the list of live groups, oldest first:
+//
+//  - an NFA state belongs only to the oldest group that has reached it, as
+//    a younger run in the same state cannot match any earlier;
+//  - a group that reaches the accepting state settles, and every younger
+//    group is dropped and no new one starts after it;
+//  - the search ends when the oldest group has settled, the first position
+//    at which the leftmost start is known.
+//
+// A transition keeps some of the old groups, in order, and may start a new
+// one at the next byte. State 0 is the idle state, in which only the run
+// from the current position is alive.
+struct dfa {
+    std::array<std::uint8_t, 256> class_of{};
+    std::size_t                   classes = 0;
+    std::size_t                   states  = 0;
+    std::size_t                   groups  = 0; // the most groups of any state
+    std::size_t                   moves   = 0;
+    bool                          empty   = false; // P matches the empty string
+
+    std::array<std::uint16_t, max_table> next{}; // state * classes + class -> state
+    std::array<std::uint16_t, max_table> keep{}; // state * classes + class -> offset in move
+    std::array<std::uint16_t, max_table> move{}; // at each offset n, then the old index of each of n kept groups
+    std::array<std::uint16_t, max_table> group_count{};
+    std::array<bool, max_table>          found{};   // the only group has settled
+    std::array<bool, max_table>          settled{}; // the last group has settled
+};
+
+constexpr dfa build(std::string_view pattern) {
+    parser         p(pattern);
+    const fragment f     = p.parse();
+    const auto&    nfa   = p.states;
+    const auto     count = nfa.size();
+
+    // Byte classes: bytes that every consuming state treats alike.
+    dfa                       d;
+    std::array<unsigned, 256> representative{};
+    for (unsigned b = 0; b < 256; ++b) {
+        std::size_t c = 0;
+        for (; c < d.classes; ++c) {
+            bool same = true;
+            for (const auto& s : nfa) {
+                if (s.consumes && s.set.contains(b) != s.set.contains(representative[c])) {
+                    same = false;
+                    break;
+                }
+            }
+            if (same) {
+                break;
+            }
+        }
+        if (c == d.classes) {
+            representative[d.classes++] = b;
+        }
+        d.class_of[b] = static_cast<std::uint8_t>(c);
+    }
+
+    // A group: its NFA states, then whether it has settled.
+    using subset       = std::vector<char>;
+    const auto closure = [&](subset& set) {
+        std::vector<std::size_t> stack;
+        for (std::size_t s = 0; s < count; ++s) {
+            if (set[s]) {
+                stack.push_back(s);
+            }
+        }
+        while (!stack.empty()) {
+            const std::size_t s = stack.back();
+            stack.pop_back();
+            for (std::size_t t : nfa[s].eps) {
+                if (t != no_state && !set[t]) {
+                    set[t] = 1;
+                    stack.push_back(t);
+                }
+            }
+        }
+    };
+
+    subset start(count + 1, 0);
+    start[f.start] = 1;
+    closure(start);
+    if (start[f.end]) {
+        d.empty = true;
+        return d;
+    }
+
+    using state = std::vector<subset>;
+    std::vector<state> states;
+    const auto         intern = [&](const state& groups) {
+        for (std::size_t k = 0; k < states.size(); ++k) {
+            if (states[k] == groups) {
+                return k;
+            }
+        }
+        if ((states.size() + 1) * d.classes > max_table) {
+            throw std::invalid_argument("pattern needs too many DFA states");
+        }
+        const std::size_t k = states.size();
+        states.push_back(groups);
+        d.group_count[k] = static_cast<std::uint16_t>(groups.size());
+        d.found[k]       = groups.size() == 1 && groups[0][count];
+        d.settled[k]     = groups.back()[count] != 0;
+        d.groups         = groups.size() > d.groups ? groups.size() : d.groups;
+        d.states         = states.size();
+        return k;
+    };
+    const auto intern_move = [&](const std::vector<std::uint16_t>& kept) {
+        for (std::size_t at = 0; at < d.moves; at += d.move[at] + 1u) {
+            if (d.move[at] == kept.size() && std::equal(kept.begin(), kept.end(), d.move.begin() + at + 1)) {
+                return at;
+            }
+        }
+        const std::size_t at = d.moves;
+        if (at + kept.size() + 1 > max_table) {
+            throw std::invalid_argument("pattern needs too many DFA states");
+        }
+        d.move[d.moves++] = static_cast<std::uint16_t>(kept.size());
+        for (std::uint16_t g : kept) {
+            d.move[d.moves++] = g;
+        }
+        return at;
+    };
+
+    intern(state{start});
+    for (std::size_t k = 0; k < states.size(); ++k) {
+        const state from = states[k];
+        for (std::size_t c = 0; c < d.classes; ++c) {
+            const unsigned             b = representative[c];
+            state                      to;
+            std::vector<std::uint16_t> kept;
+            subset                     seen(count + 1, 0);
+            const auto                 claim = [&](subset& set) {
+                bool live = false;
+                for (std::size_t s = 0; s < count; ++s) {
+                    if (set[s] && seen[s]) {
+                        set[s] = 0;
+                    } else if (set[s]) {
+                        seen[s] = 1;
+                        live    = true;
+                    }
+                }
+                return live;
+            };
+
+            bool starting = true;
+            for (std::size_t g = 0; g < from.size() && starting; ++g) {
+                subset moved(count + 1, 0);
+                if (from[g][count]) {
+                    moved[count] = 1;
+                } else {
+                    for (std::size_t s = 0; s < count; ++s) {
+                        if (from[g][s] && nfa[s].consumes && nfa[s].set.contains(b)) {
+                            moved[nfa[s].next] = 1;
+                        }
+                    }
+                    closure(moved);
+                    if (!claim(moved)) {
+                        continue;
+                    }
+                    if (moved[f.end]) {
+                        moved.assign(count + 1, 0);
+                        moved[count] = 1;
+                    }
+                }
+                starting = !moved[count];
+                to.push_back(std::move(moved));
+                kept.push_back(static_cast<std::uint16_t>(g));
+            }
+            if (subset fresh = start; starting && claim(fresh)) {
+                to.push_back(std::move(fresh));
+            }
+            d.next[k * d.classes + c] = static_cast<std::uint16_t>(intern(to));
+            d.keep[k * d.classes + c] = static_cast<std::uint16_t>(intern_move(kept));
+        }
+    }
+    return d;
+}
+
+// The DFA of pattern P, built once and copied into static tables of the
+// exact size.
+template <fixed_string P>
+struct compiled {
+    static constexpr dfa built = build(P.view());
+
+    static constexpr std::size_t states  = built.states;
+    static constexpr std::size_t classes = built.classes;
+    static constexpr std::size_t groups  = built.groups > 0 ? built.groups : 1;
+
+    struct tables {
+        std::array<std::uint8_t, 256>               class_of{};
+        std::array<std::uint16_t, states * classes> next{};
+        std::array<std::uint16_t, states * classes> keep{};
+        std::array<std::uint16_t, built.moves>      move{};
+        std::array<std::uint16_t, states>           group_count{};
+        std::array<bool, states>                    found{};
+        std::array<bool, states>                    settled{};
+        std::array<bool, 256>                       start{}; // bytes that leave the idle state
+        std::array<unsigned char, 4>                start_bytes{};
+        std::size_t                                 start_count = 0;
+    };
+
+    static constexpr tables table = [] {
+        tables t;
+        t.class_of = built.class_of;
+        for (std::size_t k = 0; k < states * classes; ++k) {
+            t.next[k] = built.next[k];
+            t.keep[k] = built.keep[k];
+        }
+        for (std::size_t k = 0; k < built.moves; ++k) {
+            t.move[k] = built.move[k];
+        }
+        for (std::size_t k = 0; k < states; ++k) {
+            t.group_count[k] = built.group_count[k];
+            t.found[k]       = built.found[k];
+            t.settled[k]     = built.settled[k];
+        }
+        for (unsigned b = 0; b < 256 && states > 0; ++b) {
+            if (t.next[t.class_of[b]] != 0 || t.move[t.keep[t.class_of[b]]] != 0) {
+                t.start[b] = true;
+                if (t.start_count < 4) {
+                    t.start_bytes[t.start_count] = static_cast<unsigned char>(b);
+                }
+                ++t.start_count;
+            }
+        }
+        return t;
+    }();
+
+    // The earliest position in [first, last) at which a match of P starts,
+    // or last, found in one pass that stops as soon as that position is
+    // known. starts holds where each group of the current state began.
+    // While idle, bytes that leave the DFA idle are skipped: on bounded
+    // contiguous input with memchr for one byte that does not, eight-byte
+    // word tests for up to four, and a table lookup otherwise.
+    template <std::forward_iterator I, std::sentinel_for<I> S>
+    static constexpr I find(I first, const S& last) {
+        using E = std::remove_cv_t<std::iter_value_t<I>>;
+        if constexpr (built.empty) {
+            return first;
+        } else {
+            std::array<I, groups> starts{};
+            std::size_t           state = 0;
+            starts[0]                   = first;
+            for (;;) {
+                if (state == 0) {
+                    if constexpr (std::contiguous_iterator<I> && std::sized_sentinel_for<S, I>) {
+                        if (!std::is_constant_evaluated()) {
+                            const auto* p = reinterpret_cast<const unsigned char*>(std::to_address(first));
+                            const auto  n = static_cast<std::size_t>(last - first);
+                            if (const auto skip =
+                                    find_any_byte(p, 0, n, table.start_bytes.data(), table.start_count, table.start)) {
+                                first += static_cast<std::iter_difference_t<I>>(skip);
+                                starts[0] = first;
+                            }
+                        }
+                    }
+                }
+                if (first == last) {
+                    break;
+                }
+                unsigned char b = to_byte(static_cast<E>(*first));
+                while (state == 0 && !table.start[b]) {
+                    starts[0] = ++first;
+                    if (first == last) {
+                        return first;
+                    }
+                    b = to_byte(static_cast<E>(*first));
+                }
+                const std::size_t t = state * classes + table.class_of[b];
+                ++first;
+                const std::size_t at   = table.keep[t];
+                const std::size_t kept = table.move[at];
+                for (std::size_t g = 0; g < kept; ++g) {
+                    starts[g] = starts[table.move[at + 1 + g]];
+                }
+                state = table.next[t];
+                if (table.group_count[state] > kept) {
+                    starts[kept] = first;
+                }
+                if (table.found[state]) {
+                    return starts[0];
+                }
+            }
+            return table.settled[state] ? starts[table.group_count[state] - 1u] : first;
+        }
+    }
+};
+
+} // namespace detail::regex
+
+// ============================================================================
+// take_before_match_view class template
+// ============================================================================
+
+// The elements of V before the earliest match of the regular expression P,
+// compiled to a DFA at compile time (see detail::regex for the syntax). If
+// P matches the empty string the view is empty. The end is located on the
+// first call to begin() or end() and cached, as for
+// take_before_any_pattern_view, so the view has the base's own iterators and
+// only non-const iteration.
+template <std::ranges::view V, fixed_string P>
+    requires std::ranges::forward_range<V> && detail::byte_element<std::remove_cv_t<std::ranges::range_value_t<V>>>
+class take_before_match_view : public std::ranges::view_interface<take_before_match_view<V, P>> {
+    V                                                         base_ = V();
+    detail::non_propagating_cache<std::ranges::iterator_t<V>> end_;
+
+  public:
+    take_before_match_view()
+        requires std::default_initializable<V>
+    = default;
+
+    constexpr explicit take_before_match_view(V base) : base_(std::move(base)) {}
+
+    constexpr V base() const&
+        requires std::copy_constructible<V>
+    {
+        return base_;
+    }
+    constexpr V base() && { return std::move(base_); }
+
+    static constexpr std::string_view pattern() { return P.view(); }
+
+    constexpr std::ranges::iterator_t<V> begin() {
+        auto first = std::ranges::begin(base_);
+        if (!end_) {
+            end_.emplace(detail::regex::compiled<P>::find(first, std::ranges::end(base_)));
+        }
+        return first;
+    }
+
+    constexpr std::ranges::iterator_t<V> end() {
+        if (!end_) {
+            begin();
+        }
+        return *end_;
+    }
+
+    constexpr auto reserve_hint()
+        requires detail::approximately_sized_range<V>
+    {
+        return detail::reserve_hint(base_);
+    }
+};
+
+} // namespace beman::take_before
+
+namespace std::ranges {
+template <class V, beman::take_before::fixed_string P>
+constexpr bool enable_borrowed_range<beman::take_before::take_before_match_view<V, P>> = enable_borrowed_range<V>;
+} // namespace std::ranges
+
+// ============================================================================
+// views::take_before_match adaptor
+// ============================================================================
+
+namespace beman::take_before::views {
+
+// r | take_before_match<"pattern">, take_before_match<"pattern">(r), or
+// take_before_match<"pattern">(i) for an unbounded search from an iterator.
+template <fixed_string P>
+struct take_before_match_fn {
+    template <std::ranges::viewable_range R>
+        requires requires { take_before_match_view<std::ranges::views::all_t<R>, P>(std::declval<R>()); }
+    constexpr auto operator()(R&& r) const {
+        return take_before_match_view<std::ranges::views::all_t<R>, P>(std::views::all(std::forward<R>(r)));
+    }
+
+    template <class I>
+        requires std::forward_iterator<std::decay_t<I>> && (!std::ranges::range<std::remove_cvref_t<I>>)
+    constexpr auto operator()(I&& i) const {
+        using Sub = std::ranges::subrange<std::decay_t<I>, std::unreachable_sentinel_t>;
+        return take_before_match_view<Sub, P>(Sub(std::decay_t<I>(std::forward<I>(i)), std::unreachable_sentinel));
+    }
+
+    template <std::ranges::viewable_range R>
+        requires requires { take_before_match_view<std::ranges::views::all_t<R>, P>(std::declval<R>()); }
+    friend constexpr auto operator|(R&& r, const take_before_match_fn& self) {
+        return self(std::forward<R>(r));
+    }
+};
+
+template <fixed_string P>
+inline constexpr take_before_match_fn<P> take_before_match;
+
+} // namespace beman::take_before::views
+
+#endif // BEMAN_TAKE_BEFORE_TAKE_BEFORE_MATCH_HPP
@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_TAKE_BEFORE_UNESCAPED_HPP
+#define BEMAN_TAKE_BEFORE_TAKE_BEFORE_UNESCAPED_HPP
+
+#include <beman/take_before/detail/find.hpp>
+#include <beman/take_before/detail/stateful_view.hpp>
+#include <beman/take_before/take_before.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace beman::take_before {
+
+namespace detail {
+
+// The first element equal to delimiter that is not escaped, i.e. not
+// preceded by an odd-length run of elements equal to escape; last if there
+// is none. An escape escapes exactly the next element, so in \\\" the quote
+// is escaped and in \\" it is not.
+//
+// Over contiguous ranges the candidates are located with the delimiter
+// search kernel (memchr), and only for each candidate is the run of escapes
+// before it counted, backwards and never past the previous candidate. The
+// runs counted are disjoint, so the whole search stays linear and text
+// without escaped delimiters costs one memchr. Other iterators carry the
+// escaped state forward one element at a time.
+template <class I, class S, class T>
+constexpr I find_unescaped(I first, const S& last, const T& delimiter, const T& escape) {
+    if constexpr (std::contiguous_iterator<I>) {
+        for (I start = first;; start = ++first) {
+            first = find_value(std::move(first), last, delimiter);
+            if (first == last) {
+                return first;
+            }
+            std::size_t run = 0;
+            for (I back = first; back != start && escape == *std::ranges::prev(back); --back) {
+                ++run;
+            }
+            if (run % 2 == 0) {
+                return first;
+            }
+        }
+    } else {
+        bool escaped = false;
+        for (; !(first == last); ++first) {
+            if (!escaped && delimiter == *first) {
+                break;
+            }
+            escaped = !escaped && escape == *first;
+        }
+        return first;
+    }
+}
+
+// The state machine of take_before_unescaped_view over (delimiter, escape).
+struct unescaped_scan {
+    class state {
+        bool escaped_ = false; // the previous element is an unpaired escape
+
+        friend struct unescaped_scan;
+    };
+
+    template <class T, class E>
+    static constexpr void advance(state& s, const T&, const T& escape, const E& e) {
+        s.escaped_ = !s.escaped_ && escape == e;
+    }
+
+    template <class T, class E>
+    static constexpr bool stops(const state& s, const T& delimiter, const T&, const E& e) {
+        return !s.escaped_ && delimiter == e;
+    }
+
+    template <class I, class S, class T>
+    static constexpr I find(I first, const S& last, const T& delimiter, const T& escape) {
+        return find_unescaped(std::move(first), last, delimiter, escape);
+    }
+};
+
+} // namespace detail
+
+// ============================================================================
+// take_before_unescaped_view class template
+// ============================================================================
+
+// The elements of V before the first element equal to the delimiter that is
+// not escaped by an odd run of escape elements: the body of a JSON string up
+// to its closing quote, a shell word up to an unquoted space. The escapes
+// themselves are part of the view; it does not unescape.
+//
+// The iterator carries one bit of state, whether the element before it was
+// an unpaired escape, so the view is at most forward. to_span() locates the
+// end of a contiguous base with detail::find_unescaped.
+template <std::ranges::view V, std::move_constructible T>
+    requires std::ranges::input_range<V> && std::is_object_v<T> &&
+             detail::indirect_delimiter<std::ranges::iterator_t<V>, T>
+class take_before_unescaped_view
+    : public detail::stateful_take_before_view<take_before_unescaped_view<V, T>, detail::unescaped_scan, V, T> {
+    using base_type =
+        detail::stateful_take_before_view<take_before_unescaped_view<V, T>, detail::unescaped_scan, V, T>;
+
+  public:
+    using base_type::base_type;
+
+    constexpr const T& delimiter() const { return this->first_value(); }
+    constexpr const T& escape() const { return this->second_value(); }
+};
+
+template <class R, class T>
+take_before_unescaped_view(R&&, T, T) -> take_before_unescaped_view<std::ranges::views::all_t<R>, T>;
+
+} // namespace beman::take_before
+
+// ============================================================================
+// views::take_before_unescaped adaptor
+// ============================================================================
+
+namespace beman::take_before::views {
+
+namespace detail {
+
+template <class T>
+class take_before_unescaped_closure {
+    T delimiter_;
+    T escape_;
+
+  public:
+    constexpr take_before_unescaped_closure(T delimiter, T escape)
+        : delimiter_(std::move(delimiter)), escape_(std::move(escape)) {}
+
+    template <std::ranges::viewable_range R>
+        requires requires {
+            beman::take_before::take_before_unescaped_view(std::declval<R>(), std::declval<T>(), std::declval<T>());
+        }
+    constexpr auto operator()(R&& r) const {
+        return beman::take_before::take_before_unescaped_view(std::forward<R>(r), delimiter_, escape_);
+    }
+
+    template <std::ranges::viewable_range R>
+        requires requires {
+            beman::take_before::take_before_unescaped_view(std::declval<R>(), std::declval<T>(), std::declval<T>());
+        }
+    friend constexpr auto operator|(R&& r, const take_before_unescaped_closure& self) {
+        return self(std::forward<R>(r));
+    }
+};
+
+} // namespace detail
+
+struct take_before_unescaped_fn {
+    template <std::ranges::viewable_range R, class T>
+        requires requires {
+            beman::take_before::take_before_unescaped_view(
+                std::declval<R>(), std::declval<std::decay_t<T>>(), std::declval<std::decay_t<T>>());
+        }
+    constexpr auto operator()(R&& r, T&& delimiter, std::type_identity_t<std::decay_t<T>> escape) const {
+        return beman::take_before::take_before_unescaped_view(
+            std::forward<R>(r), std::decay_t<T>(std::forward<T>(delimiter)), std::move(escape));
+    }
+
+    // Unbounded search from an iterator; taken by forwarding reference so
+    // that arrays such as string literals bind to the range overload.
+    template <class I, class T>
+        requires std::input_iterator<std::decay_t<I>> && (!std::ranges::range<std::remove_cvref_t<I>>) && requires {
+            beman::take_before::take_before_unescaped_view(
+                std::ranges::subrange(std::declval<std::decay_t<I>>(), std::unreachable_sentinel),
+                std::declval<std::decay_t<T>>(),
+                std::declval<std::decay_t<T>>());
+        }
+    constexpr auto operator()(I&& i, T&& delimiter, std::type_identity_t<std::decay_t<T>> escape) const {
+        return beman::take_before::take_before_unescaped_view(
+            std::ranges::subrange(std::decay_t<I>(std::forward<I>(i)), std::unreachable_sentinel),
+            std::decay_t<T>(std::forward<T>(delimiter)),
+            std::move(escape));
+    }
+
+    template <class T>
+    constexpr auto operator()(T&& delimiter, std::type_identity_t<std::decay_t<T>> escape) const {
+        return detail::take_before_unescaped_closure<std::decay_t<T>>(std::forward<T>(delimiter), std::move(escape));
+    }
+};
+
+inline constexpr take_before_unescaped_fn take_before_unescaped;
+
+} // namespace beman::take_before::views
+
+#endif // BEMAN_TAKE_BEFORE_TAKE_BEFORE_UNESCAPED_HPP
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_TO_HPP
+#define BEMAN_TAKE_BEFORE_TO_HPP
+
+#include <beman/take_before/take_before.hpp>
+
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace beman::take_before {
+
+// ============================================================================
+// to<C>: bulk materialization of take_before views
+// ============================================================================
+
+namespace detail {
+
+template <class C>
+concept reservable_container = std::ranges::sized_range<C> && requires(C& c, std::ranges::range_size_t<C> n) {
+    c.reserve(n);
+    { c.capacity() } -> std::same_as<decltype(n)>;
+};
+
+template <class C, class Ref>
+constexpr void append_one(C& c, Ref&& ref) {
+    if constexpr (requires { c.emplace_back(std::forward<Ref>(ref)); })
+        c.emplace_back(std::forward<Ref>(ref));
+    else if constexpr (requires { c.push_back(std::forward<Ref>(ref)); })
+        c.push_back(std::forward<Ref>(ref));
+    else if constexpr (requires { c.emplace(c.end(), std::forward<Ref>(ref)); })
+        c.emplace(c.end(), std::forward<Ref>(ref));
+    else
+        c.insert(c.end(), std::forward<Ref>(ref));
+}
+
+// Builds C from the common range [first, last): through C's iterator-pair
+// constructor when it has one, otherwise by one reserve and one bulk insert.
+template <class C, std::forward_iterator I, class... Args>
+constexpr C construct_from(I first, I last, Args&&... args) {
+    if constexpr (std::constructible_from<C, I, I, Args...>) {
+        return C(std::move(first), std::move(last), std::forward<Args>(args)...);
+    } else {
+        C c(std::forward<Args>(args)...);
+        if constexpr (reservable_container<C> && std::sized_sentinel_for<I, I>) {
+            c.reserve(static_cast<std::ranges::range_size_t<C>>(last - first));
+        }
+        if constexpr (requires { c.insert(c.end(), first, last); }) {
+            c.insert(c.end(), std::move(first), std::move(last));
+        } else {
+            for (; first != last; ++first) {
+                detail::append_one(c, *first);
+            }
+        }
+        return c;
+    }
+}
+
+} // namespace detail
+
+// Materializes r into a C. When r is a take_before_view (or anything else
+// offering to_span()) over a contiguous range, the end is located once with
+// the delimiter search kernel and C is built from the resulting pointer
+// pair, so std::string and std::vector allocate exactly once and copy
+// trivially copyable elements with a single memcpy. Other forward ranges are
+// walked once to find the end and then inserted as a common subrange; only
+// single-pass ranges are appended element by element, after reserving the
+// view's reserve_hint() when its base is sized.
+template <class C, std::ranges::input_range R, class... Args>
+    requires(!std::ranges::view<C>)
+constexpr C to(R&& r, Args&&... args) {
+    if constexpr (requires { r.to_span(); }) {
+        auto s = r.to_span();
+        return detail::construct_from<C>(s.data(), s.data() + s.size(), std::forward<Args>(args)...);
+    } else if constexpr (std::ranges::forward_range<R>) {
+        auto first = std::ranges::begin(r);
+        auto last  = std::ranges::next(first, std::ranges::end(r));
+        return detail::construct_from<C>(std::move(first), std::move(last), std::forward<Args>(args)...);
+    } else {
+        C c(std::forward<Args>(args)...);
+        if constexpr (detail::reservable_container<C> && requires { r.reserve_hint(); }) {
+            c.reserve(static_cast<std::ranges::range_size_t<C>>(r.reserve_hint()));
+        }
+        for (auto&& e : r) {
+            detail::append_one(c, std::forward<decltype(e)>(e));
+        }
+        return c;
+    }
+}
+
+namespace detail {
+
+template <class C, class... Args>
+class to_closure {
+    std::tuple<Args...> args_;
+
+  public:
+    template <class... A>
+    constexpr explicit to_closure(std::in_place_t, A&&... args) : args_(std::forward<A>(args)...) {}
+
+    template <std::ranges::input_range R>
+    constexpr C operator()(R&& r) const& {
+        return std::apply(
+            [&r](const Args&... args) { return beman::take_before::to<C>(std::forward<R>(r), args...); }, args_);
+    }
+
+    template <std::ranges::input_range R>
+    friend constexpr C operator|(R&& r, const to_closure& self) {
+        return self(std::forward<R>(r));
+    }
+};
+
+} // namespace detail
+
+// Pipe form: `r | to<std::string>()`.
+template <class C, class... Args>
+    requires(!std::ranges::view<C>)
+constexpr auto to(Args&&... args) {
+    return detail::to_closure<C, std::decay_t<Args>...>(std::in_place, std::forward<Args>(args)...);
+}
+
+} // namespace beman::take_before
+
+#endif // BEMAN_TAKE_BEFORE_TO_HPP
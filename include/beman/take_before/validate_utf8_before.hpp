@@ -0,0 +1,224 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_TAKE_BEFORE_VALIDATE_UTF8_BEFORE_HPP
+#define BEMAN_TAKE_BEFORE_VALIDATE_UTF8_BEFORE_HPP
+
+#include <beman/take_before/detail/find.hpp>
+#include <beman/take_before/detail/swar.hpp>
+#include <beman/take_before/length_before.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace beman::take_before {
+
+// ============================================================================
+// validate_utf8_before algorithm
+// ============================================================================
+
+// length_before for bytes that must be UTF-8: how many elements precede the
+// first one equal to value, whether value was found, and the offset of the
+// first ill-formed sequence among them. error equals distance when the
+// prefix is valid. A sequence cut short by the delimiter or by the end of
+// the range is ill-formed at its lead byte.
+template <class D>
+struct validate_utf8_before_result {
+    D    distance;
+    bool found;
+    D    error;
+
+    constexpr bool valid() const { return error == distance; }
+};
+
+namespace detail {
+
+// Well-formed UTF-8 per Unicode Table 3-7, one byte at a time: each lead
+// byte fixes the number of continuation bytes and the range of the first
+// one, which excludes overlong forms, surrogates and values past U+10FFFF.
+class utf8_checker {
+    unsigned      need_ = 0;
+    unsigned char lo_   = 0x80;
+    unsigned char hi_   = 0xBF;
+
+  public:
+    enum class step_result { ok, bad_lead, bad_continuation };
+
+    constexpr bool pending() const { return need_ != 0; }
+
+    constexpr step_result step(unsigned char b) {
+        if (need_ != 0) {
+            if (b < lo_ || b > hi_) {
+                need_ = 0;
+                return step_result::bad_continuation;
+            }
+            --need_;
+            lo_ = 0x80;
+            hi_ = 0xBF;
+            return step_result::ok;
+        }
+        if (b < 0x80) {
+            return step_result::ok;
+        }
+        if (b < 0xC2) {
+            return step_result::bad_lead;
+        }
+        if (b < 0xE0) {
+            need_ = 1;
+        } else if (b < 0xF0) {
+            need_ = 2;
+            lo_   = b == 0xE0 ? 0xA0 : 0x80;
+            hi_   = b == 0xED ? 0x9F : 0xBF;
+        } else if (b < 0xF5) {
+            need_ = 3;
+            lo_   = b == 0xF0 ? 0x90 : 0x80;
+            hi_   = b == 0xF4 ? 0x8F : 0xBF;
+        } else {
+            return step_result::bad_lead;
+        }
+        return step_result::ok;
+    }
+};
+
+// Where validation stopped: at the delimiter or the end (error < 0), or at
+// the byte that revealed the first error, whose offset is error.
+template <class I, class D>
+struct utf8_scan {
+    I it;
+    D n;
+    D error;
+};
+
+template <class I, class S, class T, class D = std::iter_difference_t<I>>
+constexpr utf8_scan<I, D> validate_utf8_scalar(I first, const S& last, const T& value) {
+    using step_result = utf8_checker::step_result;
+    utf8_checker check;
+    D            n    = 0;
+    D            lead = 0;
+    for (; !(first == last) && !(value == *first); ++first, ++n) {
+        if (!check.pending()) {
+            lead = n;
+        }
+        switch (check.step(to_byte(*first))) {
+        case step_result::ok:
+            break;
+        case step_result::bad_lead:
+            return {std::move(first), n, n};
+        case step_result::bad_continuation:
+            return {std::move(first), n, lead};
+        }
+    }
+    return {std::move(first), n, check.pending() ? lead : D(-1)};
+}
+
+// The contiguous path over n readable bytes. Between sequences, eight bytes
+// are loaded at a time and skipped while they are all ASCII and none is the
+// delimiter d; the first byte that is either is located in the same word.
+// Multi-byte sequences go through utf8_checker. After an error the rest is
+// searched with memchr.
+inline validate_utf8_before_result<std::ptrdiff_t>
+validate_utf8_bytes(const unsigned char* p, std::size_t n, bool searching, unsigned char d) {
+    using step_result = utf8_checker::step_result;
+    utf8_checker check;
+    std::size_t  i    = 0;
+    std::size_t  lead = 0;
+    std::size_t  error;
+    for (;;) {
+        if (!check.pending()) {
+            for (; i + 8 <= n; i += 8) {
+                const std::uint64_t w    = load_le(p + i);
+                const std::uint64_t stop = (w & swar_high) | (searching ? has_byte(w, d) : 0);
+                if (stop != 0) {
+                    i += static_cast<std::size_t>(std::countr_zero(stop) / 8);
+                    break;
+                }
+            }
+            lead = i;
+        }
+        if (i == n || (searching && p[i] == d)) {
+            const auto end = static_cast<std::ptrdiff_t>(i);
+            return {end, i < n, check.pending() ? static_cast<std::ptrdiff_t>(lead) : end};
+        }
+        const step_result r = check.step(p[i]);
+        if (r != step_result::ok) {
+            error = r == step_result::bad_lead ? i : lead;
+            break;
+        }
+        ++i;
+    }
+    const std::size_t stop = searching ? static_cast<std::size_t>(find_value_n(p + i, n - i, d) - p) : n;
+    return {static_cast<std::ptrdiff_t>(stop), stop < n, static_cast<std::ptrdiff_t>(error)};
+}
+
+} // namespace detail
+
+struct validate_utf8_before_fn {
+    // Finds the delimiter and validates the bytes before it in one pass.
+    // Contiguous byte ranges take the word-at-a-time path above; a range
+    // without a bound (NTBS) is measured with the strlen/strchr kernel
+    // first, since a word load past the terminator could leave the object,
+    // and then validated while the bytes are still in cache. Other ranges,
+    // and constant evaluation, feed utf8_checker one element at a time.
+    template <std::input_iterator I, std::sentinel_for<I> S, class T>
+        requires detail::byte_element<std::remove_cv_t<std::iter_value_t<I>>> &&
+                 detail::indirect_delimiter<I, T>
+    constexpr validate_utf8_before_result<std::iter_difference_t<I>>
+    operator()(I first, S last, const T& value) const {
+        using E = std::remove_cv_t<std::iter_value_t<I>>;
+        using D = std::iter_difference_t<I>;
+
+        if constexpr (std::contiguous_iterator<I> && detail::kernel_value<E, T> &&
+                      (std::sized_sentinel_for<S, I> || std::same_as<S, std::unreachable_sentinel_t>)) {
+            if (!std::is_constant_evaluated()) {
+                std::size_t n;
+                if constexpr (std::same_as<S, std::unreachable_sentinel_t>) {
+                    n = static_cast<std::size_t>(detail::find_value(first, last, value) - first);
+                } else {
+                    n = static_cast<std::size_t>(last - first);
+                }
+                const bool searching = detail::representable_as<E>(value);
+                const auto r         = detail::validate_utf8_bytes(
+                    reinterpret_cast<const unsigned char*>(std::to_address(first)), n, searching,
+                    searching ? detail::to_byte(static_cast<E>(value)) : 0);
+                return {D(r.distance), r.found || std::same_as<S, std::unreachable_sentinel_t>, D(r.error)};
+            }
+        }
+        auto scan = detail::validate_utf8_scalar(std::move(first), last, value);
+        if (scan.error < 0) {
+            return {scan.n, !(scan.it == last), scan.n};
+        }
+        const auto rest = length_before(std::move(scan.it), last, value);
+        return {scan.n + rest.distance, rest.found, scan.error};
+    }
+
+    template <std::ranges::input_range R, class T>
+        requires detail::byte_element<std::remove_cv_t<std::ranges::range_value_t<R>>> &&
+                 detail::indirect_delimiter<std::ranges::iterator_t<R>, T>
+    constexpr validate_utf8_before_result<std::ranges::range_difference_t<R>> operator()(R&& r,
+                                                                                         const T& value) const {
+        return (*this)(std::ranges::begin(r), std::ranges::end(r), value);
+    }
+
+    // Unbounded search from an iterator, as views::take_before(i, value);
+    // found is always true.
+    template <class I, class T>
+        requires std::input_iterator<std::decay_t<I>> && (!std::ranges::range<std::remove_cvref_t<I>>) &&
+                 detail::byte_element<std::remove_cv_t<std::iter_value_t<std::decay_t<I>>>> &&
+                 detail::indirect_delimiter<std::decay_t<I>, T>
+    constexpr validate_utf8_before_result<std::iter_difference_t<std::decay_t<I>>> operator()(I&&      i,
+                                                                                              const T& value) const {
+        return (*this)(std::decay_t<I>(std::forward<I>(i)), std::unreachable_sentinel, value);
+    }
+};
+
+inline constexpr validate_utf8_before_fn validate_utf8_before;
+
+} // namespace beman::take_before
+
+#endif // BEMAN_TAKE_BEFORE_VALIDATE_UTF8_BEFORE_HPP
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/byte_class.hpp>
+#include <beman/take_before/length_before.hpp>
+#include <beman/take_before/take_before.hpp>
+#include <beman/take_before/to.hpp>
+
+#include <gtest/gtest.h>
+
+#include <concepts>
+#include <cstddef>
+#include <list>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tb = beman::take_before;
+
+namespace {
+
+// RFC 9110 delimiters: the bytes that end an HTTP token.
+constexpr tb::byte_class http_separators = tb::byte_class("\"(),/:;<=>?@[\\]{} \t") | tb::byte_class::range(0, 31);
+
+std::size_t reference_length(std::string_view s, const tb::byte_class& c) {
+    std::size_t i = 0;
+    while (i < s.size() && !c.contains(static_cast<unsigned char>(s[i]))) {
+        ++i;
+    }
+    return i;
+}
+
+} // namespace
+
+TEST(ByteClassTest, membership_and_set_operations) {
+    constexpr tb::byte_class digits = tb::byte_class::range('0', '9');
+    static_assert(digits.size() == 10);
+    static_assert(digits.contains('5') && !digits.contains('a'));
+    static_assert(digits == '7' && '7' == digits && digits != 'x');
+    static_assert((~digits).size() == 246);
+    static_assert((digits & tb::byte_class{'1', 'a'}).same_members(tb::byte_class('1')));
+    static_assert(tb::byte_class{'a', 'b'}.same_members(tb::byte_class("ba")));
+    static_assert(!tb::byte_class{'a', 'b'}.same_members(tb::byte_class('a')));
+    static_assert(tb::byte_class(std::byte{0x80}).contains(0x80));
+}
+
+TEST(ByteClassTest, membership_is_not_equality) {
+    // == between a byte and a class is membership, which is not an
+    // equivalence, so classes do not pretend to be equality_comparable.
+    static_assert(!std::equality_comparable<tb::byte_class>);
+    static_assert(!std::equality_comparable_with<tb::byte_class, char>);
+    static_assert(!std::convertible_to<char, tb::byte_class>);
+    static_assert(std::constructible_from<tb::byte_class, char>);
+    static_assert(beman::take_before::detail::indirect_delimiter<const char*, tb::byte_class>);
+    static_assert(!beman::take_before::detail::indirect_delimiter<const int*, tb::byte_class>);
+}
+
+TEST(ByteClassTest, take_before_stops_at_any_member) {
+    const std::string s = "Content-Type: text/html";
+
+    EXPECT_EQ(tb::to<std::string>(s | tb::views::take_before(http_separators)), "Content-Type");
+    EXPECT_EQ(tb::take_before_sv(s, tb::byte_class("/-")), "Content");
+    EXPECT_EQ(tb::take_before_sv(s, tb::byte_class()), s);
+    EXPECT_EQ(tb::length_before(s, ~tb::byte_class::range('A', 'z')).distance, 7);
+}
+
+TEST(ByteClassTest, kernel_agrees_with_scalar) {
+    // Classes of one, up to four and many members take different kernels.
+    std::string text;
+    unsigned    seed = 99;
+    for (int k = 0; k < 4000; ++k) {
+        seed = seed * 1103515245 + 12345;
+        text.push_back(static_cast<char>((seed >> 16) % 128 + 32));
+    }
+    const tb::byte_class classes[] = {
+        tb::byte_class('~'),
+        tb::byte_class("~}|"),
+        tb::byte_class("~}|{"),
+        tb::byte_class("~}|{`"),
+        http_separators,
+        tb::byte_class::range(150, 255),
+        ~tb::byte_class::range(33, 158),
+    };
+    for (const auto& c : classes) {
+        for (std::size_t at = 0; at < text.size(); at += 61) {
+            const std::string_view s = std::string_view(text).substr(at, 200);
+            EXPECT_EQ(tb::take_before_sv(s, c).size(), reference_length(s, c)) << at;
+            const std::list<char> l(s.begin(), s.end());
+            EXPECT_EQ(static_cast<std::size_t>(tb::length_before(l, c).distance), reference_length(s, c)) << at;
+        }
+    }
+}
+
+TEST(ByteClassTest, unbounded_null_terminated) {
+    const char* s = "key: value\0after";
+
+    EXPECT_EQ(tb::take_before_sv(s, tb::byte_class(": ")), "key");
+    EXPECT_EQ(tb::take_before_sv(s, tb::byte_class{'\0', ' '}), "key:");
+    EXPECT_EQ(tb::take_before_sv(s, tb::byte_class('\0')), "key: value");
+
+    // A NUL outside the class does not stop the search.
+    EXPECT_EQ(tb::take_before_sv(s, tb::byte_class("tf")).size(), 12u);
+}
+
+TEST(ByteClassTest, byte_elements) {
+    const std::vector<std::byte> bytes = {std::byte{1}, std::byte{2}, std::byte{0xFE}, std::byte{3}};
+    EXPECT_EQ(tb::take_before_span(bytes, tb::byte_class::range(0xF0, 0xFF)).size(), 2u);
+
+    const std::u8string u = u8"café ok";
+    EXPECT_EQ(tb::take_before_sv(u, tb::byte_class::range(0x80, 0xFF)), u8"caf");
+}
+
+TEST(ByteClassTest, constant_evaluation) {
+    static_assert(tb::take_before_sv(std::string_view("a1b2"), tb::byte_class::range('0', '9')) == "a");
+    static_assert(tb::take_before_sv("GET /index", http_separators) == "GET");
+}
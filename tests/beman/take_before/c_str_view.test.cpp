@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/c_str_view.hpp>
+#include <beman/take_before/take_before.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace tb = beman::take_before;
+
+TEST(CStrViewTest, concepts) {
+    static_assert(std::ranges::contiguous_range<tb::c_str_view>);
+    static_assert(std::ranges::sized_range<tb::c_str_view>);
+    static_assert(std::ranges::borrowed_range<tb::c_str_view>);
+    static_assert(std::ranges::view<tb::c_str_view>);
+    static_assert(!std::ranges::common_range<tb::c_str_view>);
+    static_assert(std::convertible_to<tb::c_str_view, std::string_view>);
+}
+
+TEST(CStrViewTest, iterates_like_take_before) {
+    const char*    s = "hello\0hidden";
+    tb::c_str_view v(s);
+
+    std::string via_view(v.begin(), std::ranges::next(v.begin(), v.end()));
+    std::string via_take_before;
+    for (char c : tb::views::take_before(s, '\0')) {
+        via_take_before += c;
+    }
+
+    EXPECT_EQ(via_view, "hello");
+    EXPECT_EQ(via_view, via_take_before);
+    EXPECT_FALSE(v.size_known()); // iteration does not compute the length
+}
+
+TEST(CStrViewTest, length_is_computed_once) {
+    tb::c_str_view v("config.ini");
+    EXPECT_FALSE(v.size_known());
+
+    EXPECT_EQ(v.size(), 10u);
+    EXPECT_TRUE(v.size_known());
+
+    std::string_view sv = v;
+    EXPECT_EQ(sv, "config.ini");
+    EXPECT_EQ(sv.data(), v.data());
+}
+
+TEST(CStrViewTest, sentinel_uses_cached_length) {
+    char           buffer[] = "abc";
+    tb::c_str_view v(buffer);
+    (void)v.size();
+
+    // With the length cached, end() no longer depends on the terminator.
+    auto end = v.end();
+    EXPECT_TRUE(buffer + 3 == end);
+    EXPECT_FALSE(buffer + 2 == end);
+}
+
+TEST(CStrViewTest, known_length_constructors) {
+    const std::string s = "from std::string";
+    tb::c_str_view    a(s);
+    EXPECT_TRUE(a.size_known());
+    EXPECT_EQ(a.size(), s.size());
+    EXPECT_EQ(a.c_str(), s.c_str());
+
+    tb::c_str_view b("abcdef", 6);
+    EXPECT_TRUE(b.size_known());
+    EXPECT_EQ(std::string_view(b), "abcdef");
+}
+
+TEST(CStrViewTest, default_constructed_is_empty_c_string) {
+    tb::c_str_view v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.size(), 0u);
+    ASSERT_NE(v.c_str(), nullptr);
+    EXPECT_EQ(std::strlen(v.c_str()), 0u);
+}
+
+TEST(CStrViewTest, empty_does_not_need_length) {
+    tb::c_str_view v("x");
+    EXPECT_FALSE(v.empty());
+    EXPECT_FALSE(v.size_known());
+}
+
+TEST(CStrViewTest, works_with_range_algorithms) {
+    tb::c_str_view v("key=value");
+
+    auto eq = std::ranges::find(v, '=');
+    EXPECT_EQ(eq - v.begin(), 3);
+    EXPECT_EQ(std::ranges::count(v, 'e'), 2);
+}
+
+TEST(CStrViewTest, wide_characters) {
+    tb::wc_str_view v(L"wide");
+    EXPECT_EQ(v.size(), 4u);
+    EXPECT_EQ(std::wstring_view(v), L"wide");
+}
+
+TEST(CStrViewTest, constant_evaluation) {
+    static_assert(tb::c_str_view().empty());
+    static_assert(!tb::c_str_view("abc").empty());
+    static_assert(*tb::c_str_view("abc").begin() == 'a');
+}
+
+TEST(CStrViewTest, concurrent_size_on_shared_view) {
+    // const members fill the length cache atomically, so threads may share
+    // a view, and copy it, while its length is being computed.
+    const std::string        s(1000, 'x');
+    const tb::c_str_view     shared(s.c_str());
+    std::vector<std::size_t> sizes(8);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        threads.emplace_back([&, i] {
+            const tb::c_str_view copy = shared;
+            sizes[i]                  = i % 2 == 0 ? shared.size() : copy.size();
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (std::size_t n : sizes) {
+        EXPECT_EQ(n, s.size());
+    }
+    EXPECT_TRUE(shared.size_known());
+}
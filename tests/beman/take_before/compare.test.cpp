@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/compare.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <compare>
+#include <list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tb = beman::take_before;
+
+namespace {
+
+int sign(std::strong_ordering o) { return o < 0 ? -1 : o > 0 ? 1 : 0; }
+
+int sign(int c) { return c < 0 ? -1 : c > 0 ? 1 : 0; }
+
+} // namespace
+
+TEST(CompareTest, view_against_string) {
+    const std::string text = "beta=2";
+    auto              v    = text | tb::views::take_before('=');
+
+    EXPECT_TRUE(v == "beta");
+    EXPECT_TRUE(v < "betb");
+    EXPECT_TRUE(v > "bet");
+    EXPECT_TRUE(v < "beta=");
+    EXPECT_TRUE(v > "alpha");
+    EXPECT_TRUE("gamma" > v);
+    EXPECT_EQ(v <=> std::string("beta"), std::strong_ordering::equal);
+    EXPECT_EQ(std::string_view("beta") <=> v, std::strong_ordering::equal);
+}
+
+TEST(CompareTest, view_against_view) {
+    const std::string a = "key=1";
+    const std::string b = "key;2";
+    const std::string c = "kez=3";
+    const char*       d = "key";
+
+    auto va = a | tb::views::take_before('=');
+    auto vb = b | tb::views::take_before(';');
+    auto vc = c | tb::views::take_before('=');
+    auto vd = tb::views::take_before(d, '\0');
+
+    EXPECT_TRUE(va == vb);
+    EXPECT_TRUE(va == vd);
+    EXPECT_TRUE(va < vc);
+    EXPECT_TRUE(vc > vd);
+    EXPECT_EQ(vd <=> va, std::strong_ordering::equal);
+}
+
+TEST(CompareTest, matches_string_compare_across_blocks) {
+    // Prefix lengths on both sides of the internal block size, with the
+    // first difference at varying offsets.
+    for (std::size_t n : {0u, 1u, 7u, 255u, 256u, 257u, 600u}) {
+        const std::string base(n, 'x');
+        for (std::size_t at : {std::size_t(0), n / 2, n}) {
+            std::string left = base;
+            if (at < n) {
+                left[at] = 'y';
+            }
+            const std::string stored = left + "|suffix";
+            auto              v      = stored | tb::views::take_before('|');
+
+            for (const std::string& right : {base, base + "x", base.substr(0, n / 2), left}) {
+                EXPECT_EQ(sign(v <=> right), sign(left.compare(right))) << n << ' ' << at;
+                EXPECT_EQ(v == right, left == right) << n << ' ' << at;
+
+                const std::string other = right + "|";
+                auto              w     = other | tb::views::take_before('|');
+                EXPECT_EQ(sign(v <=> w), sign(left.compare(right))) << n << ' ' << at;
+                EXPECT_EQ(v == w, left == right) << n << ' ' << at;
+
+                auto u = tb::views::take_before(other.c_str(), '|');
+                EXPECT_EQ(sign(u <=> v), sign(right.compare(left))) << n << ' ' << at;
+            }
+        }
+    }
+}
+
+TEST(CompareTest, delimiter_missing) {
+    const std::string s = "abc";
+    auto              v = s | tb::views::take_before(';');
+
+    EXPECT_TRUE(v == "abc");
+    EXPECT_TRUE(v < "abcd");
+    EXPECT_TRUE(v > "ab");
+}
+
+TEST(CompareTest, characters_compare_as_unsigned) {
+    const std::string s = "a\xe9;";
+    auto              v = s | tb::views::take_before(';');
+
+    EXPECT_TRUE(v > "ab");
+    EXPECT_EQ(sign(v <=> "ab"), sign(std::string_view("a\xe9").compare("ab")));
+}
+
+TEST(CompareTest, non_contiguous_bases) {
+    const std::list<char> l = {'s', 'k', 'y', ',', 'z'};
+    auto                  v = l | tb::views::take_before(',');
+
+    EXPECT_TRUE(v == "sky");
+    EXPECT_TRUE(v < "sl");
+    EXPECT_TRUE(v > "sk");
+
+    const std::string s = "sky,";
+    EXPECT_TRUE(v == (s | tb::views::take_before(',')));
+    EXPECT_TRUE(v > (s | tb::views::take_before('k')));
+}
+
+TEST(CompareTest, wide_characters) {
+    const std::wstring s = L"wide:rest";
+    auto               v = s | tb::views::take_before(L':');
+
+    EXPECT_TRUE(v == L"wide");
+    EXPECT_TRUE(v < L"widf");
+    EXPECT_TRUE(v > std::wstring_view(L"wid"));
+}
+
+TEST(CompareTest, sortable) {
+    const std::vector<std::string> lines = {"pear:3", "apple:1", "fig:2", "apple:0"};
+
+    std::vector<decltype(lines[0] | tb::views::take_before(':'))> keys;
+    for (const auto& line : lines) {
+        keys.push_back(line | tb::views::take_before(':'));
+    }
+    std::ranges::sort(keys, std::less<>());
+
+    EXPECT_TRUE(keys[0] == "apple");
+    EXPECT_TRUE(keys[1] == keys[0]);
+    EXPECT_TRUE(keys[2] == "fig");
+    EXPECT_TRUE(keys[3] == "pear");
+}
+
+TEST(CompareTest, constant_evaluation) {
+    constexpr std::string_view s = "id=7";
+
+    static_assert((s | tb::views::take_before('=')) == "id");
+    static_assert((s | tb::views::take_before('=')) < "ie");
+    static_assert((s | tb::views::take_before('=')) == (std::string_view("id") | tb::views::take_before('=')));
+    SUCCEED();
+}
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/copy_before.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <concepts>
+#include <iterator>
+#include <list>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tb = beman::take_before;
+
+TEST(CopyBeforeTest, found) {
+    const std::string    in = "name:value";
+    std::array<char, 16> out{};
+
+    auto r = tb::copy_before(in, ':', out.begin(), out.end());
+    EXPECT_EQ(r.status, tb::copy_before_status::found);
+    EXPECT_EQ(r.in, in.begin() + 4);
+    EXPECT_EQ(r.out, out.begin() + 4);
+    EXPECT_EQ(std::string_view(out.data(), 4), "name");
+}
+
+TEST(CopyBeforeTest, exhausted) {
+    const std::string    in = "name";
+    std::array<char, 16> out{};
+
+    auto r = tb::copy_before(in, ':', out);
+    EXPECT_EQ(r.status, tb::copy_before_status::exhausted);
+    EXPECT_EQ(r.in, in.end());
+    EXPECT_EQ(r.out - out.begin(), 4);
+}
+
+TEST(CopyBeforeTest, truncated) {
+    const std::string   in = "a long field:rest";
+    std::array<char, 4> out{};
+
+    auto r = tb::copy_before(in, ':', out);
+    EXPECT_EQ(r.status, tb::copy_before_status::truncated);
+    EXPECT_EQ(r.in, in.begin() + 4);
+    EXPECT_EQ(r.out, out.end());
+    EXPECT_EQ(std::string_view(out.data(), 4), "a lo");
+}
+
+TEST(CopyBeforeTest, output_exactly_full_at_delimiter_is_found) {
+    const std::string   in = "abcd:";
+    std::array<char, 4> out{};
+
+    EXPECT_EQ(tb::copy_before(in, ':', out).status, tb::copy_before_status::found);
+}
+
+TEST(CopyBeforeTest, ntbs_source) {
+    const char* in = "hello\0world";
+    char        out[32];
+
+    auto r = tb::copy_before(in, '\0', out, out + sizeof(out));
+    EXPECT_EQ(r.status, tb::copy_before_status::found);
+    EXPECT_EQ(r.in, in + 5);
+    EXPECT_EQ(std::string_view(out, static_cast<std::size_t>(r.out - out)), "hello");
+
+    auto small = tb::copy_before(in, '\0', out, out + 3);
+    EXPECT_EQ(small.status, tb::copy_before_status::truncated);
+    EXPECT_EQ(small.in, in + 3);
+}
+
+TEST(CopyBeforeTest, longer_than_a_block) {
+    std::string in(5000, 'x');
+    in[4321] = ';';
+    std::vector<char> out(8000);
+
+    auto r = tb::copy_before(in, ';', out);
+    EXPECT_EQ(r.status, tb::copy_before_status::found);
+    EXPECT_EQ(r.in - in.begin(), 4321);
+    EXPECT_EQ(std::string(out.begin(), r.out), std::string(4321, 'x'));
+
+    std::vector<char> small(3000);
+    auto              t = tb::copy_before(in, ';', small);
+    EXPECT_EQ(t.status, tb::copy_before_status::truncated);
+    EXPECT_EQ(t.in - in.begin(), 3000);
+}
+
+TEST(CopyBeforeTest, wide_characters) {
+    const std::wstring     in = L"wide=value";
+    std::array<wchar_t, 8> out{};
+
+    auto r = tb::copy_before(in, L'=', out);
+    EXPECT_EQ(r.status, tb::copy_before_status::found);
+    EXPECT_EQ(std::wstring_view(out.data(), 4), L"wide");
+}
+
+TEST(CopyBeforeTest, non_contiguous_source_and_unbounded_output) {
+    const std::list<int> in = {1, 2, 3, 0, 4};
+    std::vector<int>     out;
+
+    auto r = tb::copy_before(in, 0, std::back_inserter(out), std::unreachable_sentinel);
+    EXPECT_EQ(r.status, tb::copy_before_status::found);
+    EXPECT_EQ(*r.in, 0);
+    EXPECT_EQ(out, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(CopyBeforeTest, temporary_source_dangles) {
+    std::array<char, 8> out{};
+
+    auto r = tb::copy_before(std::string("a:b"), ':', out);
+    static_assert(std::same_as<decltype(r.in), std::ranges::dangling>);
+    EXPECT_EQ(r.status, tb::copy_before_status::found);
+    EXPECT_EQ(r.out, out.begin() + 1);
+    EXPECT_EQ(out[0], 'a');
+
+    std::string buffer(4, '\0');
+    auto        s = tb::copy_before(std::string("abcdef"), ':', buffer.begin(), buffer.end());
+    EXPECT_EQ(s.status, tb::copy_before_status::truncated);
+    EXPECT_EQ(buffer, "abcd");
+}
+
+TEST(CopyBeforeTest, constant_evaluation) {
+    constexpr auto copied = [] {
+        std::string_view    in = "ab;c";
+        std::array<char, 8> out{};
+        auto                r = tb::copy_before(in, ';', out);
+        return r.out - out.begin();
+    }();
+    static_assert(copied == 2);
+}
@@ -0,0 +1,199 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/fd_record_reader.hpp>
+
+#include <gtest/gtest.h>
+
+#if BEMAN_TAKE_BEFORE_HAS_FD_RECORD_READER
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace tb = beman::take_before;
+
+namespace {
+
+// What a std::getline loop reads.
+std::vector<std::string> reference(const std::string& data, char delimiter) {
+    std::istringstream       in(data);
+    std::vector<std::string> out;
+    for (std::string line; std::getline(in, line, delimiter);) {
+        out.push_back(line);
+    }
+    return out;
+}
+
+std::string sample_lines(std::size_t count) {
+    std::string data;
+    for (std::size_t i = 0; i < count; ++i) {
+        data += "record " + std::to_string(i) + std::string(i % 37, 'x') + '\n';
+    }
+    return data;
+}
+
+// A file in the temporary directory, removed on destruction.
+class temp_file {
+    std::filesystem::path path_;
+
+  public:
+    temp_file(std::string_view name, std::string_view contents)
+        : path_(std::filesystem::temp_directory_path() / name) {
+        std::ofstream out(path_, std::ios::binary);
+        out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    }
+    ~temp_file() { std::filesystem::remove(path_); }
+
+    const std::filesystem::path& path() const { return path_; }
+};
+
+struct fd_closer {
+    int fd;
+    ~fd_closer() { ::close(fd); }
+};
+
+std::vector<std::string> read_file(const std::string& data, char delimiter, const tb::fd_reader_options& options,
+                                   tb::fd_reader_stats* stats = nullptr) {
+    // Named after the running test, which has a process of its own.
+    const std::string name = std::string("beman_take_before_fd_") +
+                             ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".txt";
+    temp_file file(name, data);
+    const int fd = ::open(file.path().c_str(), O_RDONLY);
+    EXPECT_GE(fd, 0);
+    fd_closer                closer{fd};
+    std::vector<std::string> out;
+    const auto s =
+        tb::fd_record_reader(fd, delimiter, options).for_each([&](std::string_view r) { out.emplace_back(r); });
+    if (stats) {
+        *stats = s;
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(FdRecordReaderTest, reads_regular_file) {
+    const std::string   data = sample_lines(1000);
+    tb::fd_reader_stats stats;
+    EXPECT_EQ(read_file(data, '\n', {}, &stats), reference(data, '\n'));
+    EXPECT_EQ(stats.bytes, data.size());
+    EXPECT_EQ(stats.records, 1000u);
+    EXPECT_GE(stats.reads, 1u);
+    EXPECT_GE(stats.bytes_per_second(), 0.0);
+    EXPECT_LE(stats.waiting, stats.elapsed);
+}
+
+TEST(FdRecordReaderTest, records_cross_buffers) {
+    const std::string data = sample_lines(500);
+    for (std::size_t size : {1u, 2u, 7u, 64u, 4096u}) {
+        for (std::size_t buffers : {2u, 3u, 8u}) {
+            tb::fd_reader_stats stats;
+            EXPECT_EQ(read_file(data, '\n', {.buffer_size = size, .buffers = buffers}, &stats), reference(data, '\n'))
+                << size << " x " << buffers;
+            EXPECT_EQ(stats.bytes, data.size());
+        }
+    }
+}
+
+TEST(FdRecordReaderTest, edge_cases) {
+    EXPECT_TRUE(read_file("", '\n', {.buffer_size = 4}).empty());
+    EXPECT_EQ(read_file("tail", '\n', {.buffer_size = 3}), (std::vector<std::string>{"tail"}));
+    EXPECT_EQ(read_file("\n\na\n", '\n', {.buffer_size = 2}), (std::vector<std::string>{"", "", "a"}));
+    EXPECT_EQ(read_file("a,b,,c", ',', {.buffer_size = 2}), (std::vector<std::string>{"a", "b", "", "c"}));
+}
+
+TEST(FdRecordReaderTest, pipe_with_short_reads) {
+    int ends[2];
+    ASSERT_EQ(::pipe(ends), 0);
+    fd_closer         closer{ends[0]};
+    const std::string data = sample_lines(20000);
+
+    // The writer trickles the data in uneven pieces, so reads return short.
+    std::thread writer([&] {
+        std::size_t at = 0;
+        for (std::size_t piece = 1; at < data.size(); piece = piece * 3 % 5000 + 1) {
+            const std::size_t n = std::min(piece, data.size() - at);
+            const auto        w = ::write(ends[1], data.data() + at, n);
+            if (w <= 0) {
+                break;
+            }
+            at += static_cast<std::size_t>(w);
+        }
+        ::close(ends[1]);
+    });
+
+    std::vector<std::string> out;
+    const auto               stats =
+        tb::fd_record_reader(ends[0], '\n', {.buffer_size = 1000, .buffers = 3}).for_each([&](std::string_view r) {
+            out.emplace_back(r);
+        });
+    writer.join();
+    EXPECT_EQ(out, reference(data, '\n'));
+    EXPECT_EQ(stats.bytes, data.size());
+    EXPECT_EQ(stats.records, out.size());
+}
+
+TEST(FdRecordReaderTest, read_error_throws_system_error) {
+    tb::fd_record_reader reader(-1);
+    try {
+        reader.for_each([](std::string_view) {});
+        ADD_FAILURE() << "expected std::system_error";
+    } catch (const std::system_error& e) {
+        EXPECT_EQ(e.code(), std::errc::bad_file_descriptor);
+    }
+}
+
+TEST(FdRecordReaderTest, records_arrive_per_read) {
+    int ends[2];
+    ASSERT_EQ(::pipe(ends), 0);
+    fd_closer read_end{ends[0]};
+    ASSERT_EQ(::write(ends[1], "first\n", 6), 6);
+
+    // The second record is written only once the first has arrived, which
+    // it must do although it fills a fraction of the buffer.
+    std::vector<std::string> out;
+    tb::fd_record_reader(ends[0], '\n', {.buffer_size = 4096}).for_each([&](std::string_view r) {
+        out.emplace_back(r);
+        if (out.size() == 1) {
+            EXPECT_EQ(::write(ends[1], "second\n", 7), 7);
+            ::close(ends[1]);
+        }
+    });
+    EXPECT_EQ(out, (std::vector<std::string>{"first", "second"}));
+}
+
+TEST(FdRecordReaderTest, callback_exception_stops_idle_reader) {
+    int ends[2];
+    ASSERT_EQ(::pipe(ends), 0);
+    fd_closer read_end{ends[0]};
+    fd_closer write_end{ends[1]};
+    ASSERT_EQ(::write(ends[1], "a\nb\n", 4), 4);
+
+    // The write end stays open and nothing more is written, so the reader
+    // thread waits for input; for_each must still stop it and rethrow.
+    int  seen = 0;
+    auto f    = [&](std::string_view) {
+        if (++seen == 2) {
+            throw std::runtime_error("stop");
+        }
+    };
+    EXPECT_THROW(tb::fd_record_reader(ends[0], '\n', {.buffer_size = 2}).for_each(f), std::runtime_error);
+    EXPECT_EQ(seen, 2);
+}
+
+TEST(FdRecordReaderTest, max_record_throws_length_error) {
+    EXPECT_THROW(read_file("short\nmuch too long\n", '\n', {.buffer_size = 4, .max_record = 8}), std::length_error);
+}
+
+#endif // BEMAN_TAKE_BEFORE_HAS_FD_RECORD_READER
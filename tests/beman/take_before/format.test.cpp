@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/format.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+#include <list>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
+
+namespace tb = beman::take_before;
+
+TEST(FormatTest, ostream_contiguous) {
+    const std::string  s = "Hello, world! Stop here.";
+    std::ostringstream out;
+
+    out << (s | tb::views::take_before('!'));
+    EXPECT_EQ(out.str(), "Hello, world");
+}
+
+TEST(FormatTest, ostream_ntbs) {
+    const char*        s = "field\0garbage";
+    std::ostringstream out;
+
+    out << '[' << tb::views::take_before(s, '\0') << ']';
+    EXPECT_EQ(out.str(), "[field]");
+}
+
+TEST(FormatTest, ostream_honors_width_and_fill) {
+    const std::string  s = "ab|cd";
+    std::ostringstream out;
+
+    out << std::setw(6) << std::setfill('.') << (s | tb::views::take_before('|'));
+    out << std::left << std::setw(4) << (s | tb::views::take_before('|'));
+    EXPECT_EQ(out.str(), "....abab..");
+}
+
+TEST(FormatTest, ostream_non_contiguous) {
+    std::list<char> l;
+    for (int i = 0; i < 1000; ++i) {
+        l.push_back(static_cast<char>('a' + i % 26));
+    }
+    l.push_back('#');
+    l.push_back('z');
+
+    std::ostringstream out;
+    out << (l | tb::views::take_before('#'));
+    EXPECT_EQ(out.str().size(), 1000u);
+    EXPECT_EQ(out.str().substr(0, 3), "abc");
+
+    std::ostringstream padded;
+    padded << std::setw(5) << (l | std::views::take(2) | tb::views::take_before('#'));
+    EXPECT_EQ(padded.str(), "   ab");
+}
+
+TEST(FormatTest, ostream_wide) {
+    const std::wstring  s = L"wide=value";
+    std::wostringstream out;
+
+    out << (s | tb::views::take_before(L'='));
+    EXPECT_EQ(out.str(), L"wide");
+}
+
+#if defined(__cpp_lib_format)
+TEST(FormatTest, formatter) {
+    const std::string s = "key:value";
+
+    EXPECT_EQ(std::format("{}", s | tb::views::take_before(':')), "key");
+    EXPECT_EQ(std::format("[{:>5}]", s | tb::views::take_before(':')), "[  key]");
+    EXPECT_EQ(std::format("{}", tb::views::take_before("abc;", ';')), "abc");
+
+    std::list<char> l = {'x', 'y', ';', 'z'};
+    EXPECT_EQ(std::format("{}", l | tb::views::take_before(';')), "xy");
+}
+#endif
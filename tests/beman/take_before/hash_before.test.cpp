@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/hash_before.hpp>
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace tb = beman::take_before;
+
+TEST(HashBeforeTest, matches_hash_of_prefix_string) {
+    const tb::transparent_hash hash;
+    const std::string          text = "symbol_name_that_spans_words=42";
+
+    for (std::size_t n = 0; n <= 28; ++n) {
+        std::string s = text.substr(0, n) + "=tail";
+        EXPECT_EQ(tb::hash_before(s, '='), hash(text.substr(0, n))) << n;
+    }
+}
+
+TEST(HashBeforeTest, all_input_kinds_agree) {
+    const tb::transparent_hash hash;
+    const std::string          key = "environment_variable";
+    const std::size_t          h   = hash(key);
+
+    const char*           ntbs = "environment_variable\0junk";
+    const std::list<char> list(key.begin(), key.end());
+    std::string           with_delim = key + ";x";
+
+    EXPECT_EQ(tb::hash_before(ntbs, '\0'), h);
+    EXPECT_EQ(tb::hash_before(list, ';'), h);
+    EXPECT_EQ(tb::hash_before(with_delim, ';'), h);
+    EXPECT_EQ(hash(std::string_view(key)), h);
+    EXPECT_EQ(hash(key.c_str()), h);
+    EXPECT_EQ(hash(tb::views::take_before(ntbs, '\0')), h);
+    EXPECT_EQ(hash(list | tb::views::take_before(';')), h);
+
+    auto view = with_delim | tb::views::take_before(';');
+    EXPECT_EQ(std::hash<decltype(view)>{}(view), h);
+}
+
+TEST(HashBeforeTest, delimiter_not_found_hashes_whole_range) {
+    const std::string s = "no-delimiter-here";
+
+    EXPECT_EQ(tb::hash_before(s, '|'), tb::transparent_hash{}(s));
+}
+
+TEST(HashBeforeTest, different_prefixes_differ) {
+    EXPECT_NE(tb::hash_before(std::string("abc:"), ':'), tb::hash_before(std::string("abd:"), ':'));
+    EXPECT_NE(tb::hash_before(std::string("ab:"), ':'), tb::hash_before(std::string("ab\0:", 4), ':'));
+    EXPECT_NE(tb::hash_before(std::string("abc"), ':', 1), tb::hash_before(std::string("abc"), ':', 2));
+}
+
+TEST(HashBeforeTest, wide_characters) {
+    const std::wstring s = L"wide_key=value";
+
+    EXPECT_EQ(tb::hash_before(s, L'='), tb::transparent_hash{}(std::wstring_view(L"wide_key")));
+    EXPECT_EQ(tb::hash_before(std::list<wchar_t>(s.begin(), s.end()), L'='), tb::hash_before(s, L'='));
+}
+
+TEST(HashBeforeTest, view_equals_string) {
+    const char* s = "key=value";
+    auto        v = tb::views::take_before(s, '=');
+
+    EXPECT_TRUE(v == std::string("key"));
+    EXPECT_TRUE(std::string_view("key") == v);
+    EXPECT_FALSE(v == "ke");
+    EXPECT_FALSE(v == "key=");
+    EXPECT_FALSE(v == "keys");
+}
+
+TEST(HashBeforeTest, heterogeneous_lookup) {
+    std::unordered_map<std::string, int, tb::transparent_hash, std::equal_to<>> m = {
+        {"PATH", 1}, {"HOME", 2}, {"SHELL", 3}};
+
+    const char* environ_entry = "HOME=/root";
+    auto        it            = m.find(tb::views::take_before(environ_entry, '='));
+    ASSERT_NE(it, m.end());
+    EXPECT_EQ(it->second, 2);
+
+    const char* other = "TERM=xterm";
+    EXPECT_EQ(m.find(tb::views::take_before(other, '=')), m.end());
+
+    std::unordered_set<std::string, tb::transparent_hash, std::equal_to<>> s = {"alpha", "beta"};
+    std::vector<char>                                                      buf = {'b', 'e', 't', 'a', '\0', 'z'};
+    EXPECT_TRUE(s.contains(buf | tb::views::take_before('\0')));
+}
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/length_before.hpp>
+#include <beman/take_before/take_before.hpp>
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <list>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tb = beman::take_before;
+
+TEST(LengthBeforeTest, contiguous_found) {
+    const std::string s = "name:value";
+    auto              r = tb::length_before(s, ':');
+
+    EXPECT_EQ(r.distance, 4);
+    EXPECT_TRUE(r.found);
+}
+
+TEST(LengthBeforeTest, contiguous_not_found) {
+    const std::string s = "name";
+    auto              r = tb::length_before(s, ':');
+
+    EXPECT_EQ(r.distance, 4);
+    EXPECT_FALSE(r.found);
+}
+
+TEST(LengthBeforeTest, matches_distance_of_view) {
+    const std::vector<int> v = {5, 6, 7, 8, 9};
+    for (int x : {5, 7, 9, 10}) {
+        auto r = tb::length_before(v, x);
+        EXPECT_EQ(r.distance, std::ranges::distance(v | tb::views::take_before(x)));
+        EXPECT_EQ(r.found, x != 10);
+    }
+}
+
+TEST(LengthBeforeTest, ntbs_pointer_is_strlen) {
+    const char* s = "Hello\0World";
+    auto        r = tb::length_before(s, '\0');
+
+    EXPECT_EQ(r.distance, 5);
+    EXPECT_TRUE(r.found);
+    EXPECT_EQ(tb::length_before(s, 'l').distance, 2);
+}
+
+TEST(LengthBeforeTest, wide_pointer) {
+    const wchar_t* s = L"wide\0string";
+
+    EXPECT_EQ(tb::length_before(s, L'\0').distance, 4);
+    EXPECT_EQ(tb::length_before(s, L'd').distance, 2);
+}
+
+TEST(LengthBeforeTest, bit_packed_vector_bool) {
+    const std::vector<bool> v = {true, true, true, false, true};
+
+    auto r = tb::length_before(v, false);
+    EXPECT_EQ(r.distance, 3);
+    EXPECT_TRUE(r.found);
+}
+
+TEST(LengthBeforeTest, segmented_deque) {
+    std::deque<int> d;
+    for (int i = 0; i < 5000; ++i) {
+        d.push_back(i);
+    }
+
+    auto r = tb::length_before(d, 4321);
+    EXPECT_EQ(r.distance, 4321);
+    EXPECT_TRUE(r.found);
+}
+
+TEST(LengthBeforeTest, bidirectional_list) {
+    const std::list<int> l = {1, 2, 3, 4};
+
+    auto r = tb::length_before(l, 3);
+    EXPECT_EQ(r.distance, 2);
+    EXPECT_TRUE(r.found);
+}
+
+TEST(LengthBeforeTest, single_pass_input_range) {
+    std::istringstream in("1 2 3 4 5");
+
+    auto r = tb::length_before(std::views::istream<int>(in), 4);
+    EXPECT_EQ(r.distance, 3);
+    EXPECT_TRUE(r.found);
+}
+
+TEST(LengthBeforeTest, iterator_sentinel_pair) {
+    const std::vector<int> v = {1, 2, 3, 4};
+
+    auto r = tb::length_before(v.begin() + 1, v.end(), 4);
+    EXPECT_EQ(r.distance, 2);
+    EXPECT_TRUE(r.found);
+}
+
+TEST(LengthBeforeTest, constant_evaluation) {
+    static_assert(tb::length_before(std::string_view("abc:d"), ':').distance == 3);
+    static_assert(!tb::length_before(std::string_view("abc"), ':').found);
+
+    constexpr const char* s = "constexpr";
+    static_assert(tb::length_before(s, '\0').distance == 9);
+}
+
+TEST(LengthBeforeTest, mixed_sign_delimiters) {
+    // '\xff' is -1 as a char, and no unsigned char promotes to -1.
+    const std::vector<unsigned char> u = {1, 2, 0xff, 3};
+    EXPECT_EQ(tb::length_before(u, '\xff').distance, 4);
+    EXPECT_FALSE(tb::length_before(u, '\xff').found);
+    EXPECT_EQ(tb::length_before(u, static_cast<unsigned char>(0xff)).distance, 2);
+
+    // 200 is no signed char, even though (signed char)200 is -56.
+    const std::vector<signed char> s = {1, static_cast<signed char>(200), 3};
+    EXPECT_FALSE(tb::length_before(s, static_cast<unsigned char>(200)).found);
+    EXPECT_EQ(tb::length_before(s, static_cast<signed char>(-56)).distance, 1);
+
+    // The contiguous scan agrees with plain iteration.
+    EXPECT_EQ(tb::length_before(u, '\xff').distance, std::ranges::distance(tb::views::take_before(u, '\xff')));
+    EXPECT_EQ(tb::length_before(u, static_cast<signed char>(2)).distance, 1);
+}
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/mapped_records.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace tb = beman::take_before;
+
+namespace {
+
+// A file in the temporary directory, removed on destruction.
+class temp_file {
+    std::filesystem::path path_;
+
+  public:
+    temp_file(std::string_view name, std::string_view contents)
+        : path_(std::filesystem::temp_directory_path() / name) {
+        std::ofstream out(path_, std::ios::binary);
+        out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    }
+    ~temp_file() { std::filesystem::remove(path_); }
+
+    const std::filesystem::path& path() const { return path_; }
+};
+
+std::vector<std::string_view> collect(const tb::mapped_records& records) {
+    std::vector<std::string_view> out;
+    for (std::string_view record : records) {
+        out.push_back(record);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(MappedRecordsTest, records_are_views_into_the_mapping) {
+    temp_file file("beman_take_before_mapped_1.txt", "first line\nsecond\n\nlast\n");
+
+    const tb::mapped_records records(file.path());
+    EXPECT_EQ(collect(records), (std::vector<std::string_view>{"first line", "second", "", "last"}));
+    EXPECT_EQ(records.file().size(), 24u);
+    EXPECT_EQ((*records.begin()).data(), records.file().data());
+}
+
+TEST(MappedRecordsTest, final_record_without_delimiter) {
+    temp_file file("beman_take_before_mapped_2.txt", "a,b,,c");
+
+    const tb::mapped_records records(file.path(), ',');
+    EXPECT_EQ(collect(records), (std::vector<std::string_view>{"a", "b", "", "c"}));
+}
+
+TEST(MappedRecordsTest, empty_file_has_no_records) {
+    temp_file file("beman_take_before_mapped_3.txt", "");
+
+    const tb::mapped_records records(file.path());
+    EXPECT_TRUE(records.empty());
+    EXPECT_EQ(records.file().size(), 0u);
+}
+
+TEST(MappedRecordsTest, options_are_hints) {
+    std::string contents;
+    for (int k = 0; k < 10000; ++k) {
+        contents += "record " + std::to_string(k) + '\n';
+    }
+    temp_file file("beman_take_before_mapped_4.txt", contents);
+
+    tb::map_options options;
+    options.will_need  = true;
+    options.huge_pages = true;
+    options.populate   = true;
+    const tb::mapped_records records(file.path(), '\n', options);
+    EXPECT_EQ(std::ranges::distance(records), 10000);
+    EXPECT_EQ(*std::ranges::next(records.begin(), 1234), "record 1234");
+}
+
+TEST(MappedRecordsTest, missing_file_throws_system_error) {
+    const auto path = std::filesystem::temp_directory_path() / "beman_take_before_mapped_missing.txt";
+    try {
+        tb::mapped_records records(path);
+        FAIL() << "expected std::system_error";
+    } catch (const std::system_error& e) {
+        EXPECT_EQ(e.code(), std::errc::no_such_file_or_directory);
+    }
+}
+
+TEST(MappedRecordsTest, move_keeps_the_mapping) {
+    temp_file file("beman_take_before_mapped_5.txt", "x\ny\n");
+
+    tb::mapped_records records(file.path());
+    const char*        data  = records.file().data();
+    tb::mapped_records moved = std::move(records);
+    EXPECT_EQ(moved.file().data(), data);
+    EXPECT_EQ(collect(moved), (std::vector<std::string_view>{"x", "y"}));
+
+    static_assert(std::ranges::forward_range<const tb::mapped_records>);
+    static_assert(std::ranges::view<tb::mapped_records>);
+    static_assert(!std::ranges::borrowed_range<tb::mapped_records>);
+}
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/parse_before.hpp>
+
+#include <gtest/gtest.h>
+
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <version>
+
+namespace tb = beman::take_before;
+
+TEST(ParseBeforeTest, integer_field) {
+    const std::string s = "1234,5678";
+    auto              r = tb::parse_before<int>(s, ',');
+
+    EXPECT_EQ(r.ec, std::errc());
+    EXPECT_EQ(r.value, 1234);
+    EXPECT_EQ(r.end - s.begin(), 4);
+
+    auto next = tb::parse_before<int>(std::ranges::subrange(r.end + 1, s.end()), ',');
+    EXPECT_EQ(next.value, 5678);
+    EXPECT_EQ(next.end, s.end());
+}
+
+TEST(ParseBeforeTest, signs) {
+    EXPECT_EQ(tb::parse_before<int>(std::string_view("-42;"), ';').value, -42);
+    EXPECT_EQ(tb::parse_before<unsigned>(std::string_view("-42;"), ';').ec, std::errc::invalid_argument);
+    EXPECT_EQ(tb::parse_before<int>(std::string_view("+42;"), ';').ec, std::errc::invalid_argument);
+    EXPECT_EQ(tb::parse_before<int>(std::string_view("-;"), ';').ec, std::errc::invalid_argument);
+}
+
+TEST(ParseBeforeTest, invalid_fields_still_report_end) {
+    const std::string s = "12a4|next";
+    auto              r = tb::parse_before<int>(s, '|');
+
+    EXPECT_EQ(r.ec, std::errc::invalid_argument);
+    EXPECT_EQ(r.value, 0);
+    EXPECT_EQ(*r.end, '|');
+
+    auto empty = tb::parse_before<int>(std::string_view("|x"), '|');
+    EXPECT_EQ(empty.ec, std::errc::invalid_argument);
+}
+
+TEST(ParseBeforeTest, limits) {
+    using i64 = std::int64_t;
+    using u64 = std::uint64_t;
+
+    EXPECT_EQ(tb::parse_before<i64>(std::string_view("9223372036854775807,"), ',').value,
+              std::numeric_limits<i64>::max());
+    EXPECT_EQ(tb::parse_before<i64>(std::string_view("-9223372036854775808,"), ',').value,
+              std::numeric_limits<i64>::min());
+    EXPECT_EQ(tb::parse_before<i64>(std::string_view("9223372036854775808,"), ',').ec,
+              std::errc::result_out_of_range);
+    EXPECT_EQ(tb::parse_before<u64>(std::string_view("18446744073709551615,"), ',').value,
+              std::numeric_limits<u64>::max());
+    EXPECT_EQ(tb::parse_before<u64>(std::string_view("18446744073709551616,"), ',').ec,
+              std::errc::result_out_of_range);
+    EXPECT_EQ(tb::parse_before<u64>(std::string_view("000000000000000000000000000042,"), ',').value, 42u);
+    EXPECT_EQ(tb::parse_before<std::int8_t>(std::string_view("-128,"), ',').value, -128);
+    EXPECT_EQ(tb::parse_before<std::int8_t>(std::string_view("128,"), ',').ec, std::errc::result_out_of_range);
+    EXPECT_EQ(tb::parse_before<std::uint16_t>(std::string_view("12345678,"), ',').ec,
+              std::errc::result_out_of_range);
+    EXPECT_EQ(tb::parse_before<std::uint16_t>(std::string_view("99999999999x,"), ',').ec,
+              std::errc::invalid_argument);
+}
+
+TEST(ParseBeforeTest, matches_from_chars_for_every_length) {
+    const std::string digits = "12345678901234567890";
+    for (std::size_t n = 1; n <= digits.size(); ++n) {
+        const std::string field = digits.substr(0, n);
+        const std::string s     = field + ",999999999";
+
+        std::uint64_t expected{};
+        const auto    fc = std::from_chars(field.data(), field.data() + n, expected);
+        const auto    r  = tb::parse_before<std::uint64_t>(s, ',');
+        EXPECT_EQ(r.ec, fc.ec) << n;
+        if (fc.ec == std::errc()) {
+            EXPECT_EQ(r.value, expected) << n;
+        }
+        EXPECT_EQ(r.end - s.begin(), static_cast<std::ptrdiff_t>(n));
+    }
+}
+
+TEST(ParseBeforeTest, digit_delimiter) {
+    EXPECT_EQ(tb::parse_before<long>(std::string_view("1234567801234567"), '0').value, 12345678);
+}
+
+TEST(ParseBeforeTest, non_contiguous_and_unbounded) {
+    const std::list<char> l = {'7', '7', '7', ' ', '1'};
+    auto                  r = tb::parse_before<short>(l, ' ');
+    EXPECT_EQ(r.value, 777);
+    EXPECT_EQ(*r.end, ' ');
+
+    std::istringstream in("-31337\n");
+    auto               ri = tb::parse_before<int>(
+        std::ranges::subrange(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()), '\n');
+    EXPECT_EQ(ri.value, -31337);
+
+    const char* ntbs = "2718281828";
+    EXPECT_EQ(tb::parse_before<long long>(ntbs, '\0').value, 2718281828LL);
+}
+
+TEST(ParseBeforeTest, temporary_string) {
+    auto r = tb::parse_before<int>(std::string("12,3"), ',');
+    static_assert(std::same_as<decltype(r.end), std::ranges::dangling>);
+    EXPECT_EQ(r.value, 12);
+    EXPECT_EQ(r.ec, std::errc());
+
+    EXPECT_EQ(tb::parse_before<unsigned>(std::string("x1"), ',').ec, std::errc::invalid_argument);
+}
+
+TEST(ParseBeforeTest, constant_evaluation) {
+    static_assert(tb::parse_before<int>(std::string_view("12345678912,"), ',').ec == std::errc::result_out_of_range);
+    static_assert(tb::parse_before<long long>(std::string_view("12345678912,"), ',').value == 12345678912LL);
+    SUCCEED();
+}
+
+#if defined(__cpp_lib_to_chars)
+TEST(ParseBeforeTest, floating_point) {
+    const std::string s = "3.25,-1e3";
+    auto              r = tb::parse_before<double>(s, ',');
+    EXPECT_EQ(r.ec, std::errc());
+    EXPECT_EQ(r.value, 3.25);
+    EXPECT_EQ(*r.end, ',');
+
+    const std::list<char> l(s.begin(), s.end());
+    EXPECT_EQ(tb::parse_before<float>(l, ',').value, 3.25f);
+
+    const std::string long_field = "0." + std::string(100, '0') + "5;";
+    const std::list<char> ll(long_field.begin(), long_field.end());
+    EXPECT_EQ(tb::parse_before<double>(ll, ';').ec, std::errc());
+    EXPECT_EQ(tb::parse_before<double>(ll, ';').value, 5e-101);
+
+    EXPECT_EQ(tb::parse_before<double>(std::string_view("1.5x;"), ';').ec, std::errc::invalid_argument);
+}
+#endif
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/record_splitter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tb = beman::take_before;
+
+namespace {
+
+// What a std::getline loop reads.
+std::vector<std::string> reference(const std::string& data, char delimiter) {
+    std::istringstream       in(data);
+    std::vector<std::string> out;
+    for (std::string line; std::getline(in, line, delimiter);) {
+        out.push_back(line);
+    }
+    return out;
+}
+
+std::vector<std::string> split_in_chunks(const std::string& data, char delimiter, std::size_t chunk) {
+    tb::record_splitter      splitter(delimiter);
+    std::vector<std::string> out;
+    const auto               collect = [&](std::string_view record) { out.emplace_back(record); };
+    for (std::size_t at = 0; at < data.size(); at += chunk) {
+        splitter.feed(std::string_view(data).substr(at, chunk), collect);
+    }
+    splitter.finish(collect);
+    return out;
+}
+
+} // namespace
+
+TEST(RecordSplitterTest, matches_getline_for_any_chunking) {
+    const std::vector<std::string> inputs = {
+        "", "\n", "\n\n", "a", "a\n", "ab\ncd", "line one\nline two\n\nline four\n", "no delimiter at all",
+    };
+    for (const auto& data : inputs) {
+        for (std::size_t chunk : {1u, 2u, 3u, 5u, 8u, 1000u}) {
+            EXPECT_EQ(split_in_chunks(data, '\n', chunk), reference(data, '\n')) << data << ' ' << chunk;
+        }
+    }
+}
+
+TEST(RecordSplitterTest, records_within_a_chunk_are_not_copied) {
+    const std::string chunk = "key=1;key=2;par";
+
+    tb::record_splitter           splitter(';');
+    std::vector<std::string_view> seen;
+    splitter.feed(chunk, [&](std::string_view record) { seen.push_back(record); });
+
+    ASSERT_EQ(seen.size(), 2u);
+    EXPECT_EQ(seen[0].data(), chunk.data());
+    EXPECT_EQ(seen[1].data(), chunk.data() + 6);
+    EXPECT_EQ(splitter.carried(), 3u);
+
+    std::string stitched;
+    splitter.feed("tial;", [&](std::string_view record) { stitched = record; });
+    EXPECT_EQ(stitched, "partial");
+    EXPECT_EQ(splitter.carried(), 0u);
+    EXPECT_FALSE(splitter.finish([](std::string_view) { FAIL(); }));
+}
+
+TEST(RecordSplitterTest, max_record_bounds_the_carry) {
+    tb::record_splitter splitter('\n', 8);
+    const auto          ignore = [](std::string_view) {};
+
+    splitter.feed("12345678\nabc", ignore); // a full-length record inside the chunk is fine
+    splitter.feed("defgh", ignore);
+    EXPECT_EQ(splitter.carried(), 8u);
+    EXPECT_THROW(splitter.feed("i", ignore), std::length_error);
+}
+
+TEST(RecordSplitterTest, max_record_bounds_records_within_a_chunk) {
+    tb::record_splitter      splitter(',', 4);
+    std::vector<std::string> out;
+    const auto               collect = [&](std::string_view record) { out.emplace_back(record); };
+
+    EXPECT_THROW(splitter.feed("ab,abcd,abcde,c", collect), std::length_error);
+    EXPECT_EQ(out, (std::vector<std::string>{"ab", "abcd"}));
+
+    tb::record_splitter whole(',', 4);
+    EXPECT_THROW(whole.feed("abcdefgh,", collect), std::length_error);
+}
+
+TEST(RecordSplitterTest, wide_records) {
+    tb::wrecord_splitter      splitter(L',');
+    std::vector<std::wstring> out;
+    const auto                collect = [&](std::wstring_view record) { out.emplace_back(record); };
+
+    splitter.feed(L"a,b", collect);
+    splitter.feed(L"c,", collect);
+    EXPECT_FALSE(splitter.finish(collect));
+    EXPECT_EQ(out, (std::vector<std::wstring>{L"a", L"bc"}));
+}
@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/resumable_scanner.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tb = beman::take_before;
+
+namespace {
+
+// Delivers data in segments of varying length, like reads from a socket.
+class segment_producer {
+    std::string_view data_;
+    std::size_t      at_   = 0;
+    std::size_t      step_ = 1;
+
+  public:
+    explicit segment_producer(std::string_view data) : data_(data) {}
+
+    bool done() const { return at_ == data_.size(); }
+
+    std::string_view next() {
+        const auto segment = data_.substr(at_, step_);
+        at_ += segment.size();
+        step_ = step_ * 7 % 13 + 1;
+        return segment;
+    }
+};
+
+} // namespace
+
+TEST(ResumableScannerTest, finds_delimiter_in_one_scan) {
+    const std::string         buffer = "key=value\nrest";
+    tb::resumable_scanner     scanner('\n');
+    tb::resumable_scan_result r = scanner.scan(buffer);
+
+    EXPECT_EQ(r.status, tb::scan_status::found);
+    EXPECT_TRUE(r);
+    EXPECT_EQ(r.position, 9u);
+    EXPECT_EQ(scanner.searched(), 9u);
+
+    // Found stays found until the record is consumed.
+    EXPECT_EQ(scanner.scan(buffer).position, 9u);
+    scanner.consume(10);
+    EXPECT_EQ(scanner.searched(), 0u);
+    r = scanner.scan(std::string_view(buffer).substr(10));
+    EXPECT_EQ(r.status, tb::scan_status::need_more);
+    EXPECT_EQ(r.position, 4u);
+}
+
+TEST(ResumableScannerTest, resumes_after_append) {
+    std::string           buffer = "abc";
+    tb::resumable_scanner scanner('\n');
+
+    EXPECT_EQ(scanner.scan(buffer).status, tb::scan_status::need_more);
+    EXPECT_EQ(scanner.searched(), 3u);
+    EXPECT_EQ(scanner.scan(buffer).status, tb::scan_status::need_more);
+
+    buffer += "de\nf";
+    const auto r = scanner.scan(buffer);
+    EXPECT_EQ(r.status, tb::scan_status::found);
+    EXPECT_EQ(r.position, 5u);
+}
+
+TEST(ResumableScannerTest, tolerates_reallocation) {
+    std::vector<char>     buffer = {'x', 'y'};
+    tb::resumable_scanner scanner('\n');
+    EXPECT_EQ(scanner.scan(buffer).status, tb::scan_status::need_more);
+
+    const char* before = buffer.data();
+    buffer.insert(buffer.end(), 4096, 'z');
+    buffer.push_back('\n');
+    ASSERT_NE(buffer.data(), before);
+
+    const auto r = scanner.scan(buffer);
+    EXPECT_EQ(r.status, tb::scan_status::found);
+    EXPECT_EQ(r.position, 4098u);
+}
+
+TEST(ResumableScannerTest, budget_bounds_each_scan) {
+    const std::string     buffer = std::string(100, 'a') + "\n";
+    tb::resumable_scanner scanner('\n');
+
+    int calls = 0;
+    for (;;) {
+        const auto before = scanner.searched();
+        const auto r      = scanner.scan(buffer, 16);
+        ++calls;
+        EXPECT_LE(scanner.searched() - before, 16u);
+        if (r.status == tb::scan_status::found) {
+            EXPECT_EQ(r.position, 100u);
+            break;
+        }
+        EXPECT_EQ(r.status, tb::scan_status::budget_exhausted);
+        EXPECT_EQ(r.position, scanner.searched());
+    }
+    EXPECT_EQ(calls, 7);
+
+    tb::resumable_scanner zero('\n');
+    EXPECT_EQ(zero.scan(buffer, 0).status, tb::scan_status::budget_exhausted);
+    EXPECT_EQ(zero.searched(), 0u);
+    EXPECT_EQ(tb::resumable_scanner('\n').scan(std::string_view(), 0).status, tb::scan_status::need_more);
+}
+
+TEST(ResumableScannerTest, budget_exhausted_at_end_of_buffer_is_need_more) {
+    const std::string     buffer(16, 'a');
+    tb::resumable_scanner scanner('\n');
+    EXPECT_EQ(scanner.scan(buffer, 16).status, tb::scan_status::need_more);
+}
+
+TEST(ResumableScannerTest, segmented_producer_is_searched_once) {
+    std::string data;
+    for (int i = 0; i < 200; ++i) {
+        data += std::string(static_cast<std::size_t>(i * 3), 'x') + std::to_string(i) + '\n';
+    }
+
+    segment_producer         producer(data);
+    tb::resumable_scanner    scanner('\n');
+    std::string              buffer;
+    std::vector<std::string> records;
+    std::size_t              examined = 0;
+    while (!producer.done()) {
+        buffer += producer.next();
+        for (;;) {
+            const auto before = scanner.searched();
+            const auto r      = scanner.scan(buffer);
+            examined += scanner.searched() - before;
+            if (!r) {
+                break;
+            }
+            records.emplace_back(buffer, 0, r.position);
+            buffer.erase(0, r.position + 1);
+            scanner.consume(r.position + 1);
+        }
+    }
+
+    ASSERT_EQ(records.size(), 200u);
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_EQ(records[static_cast<std::size_t>(i)],
+                  std::string(static_cast<std::size_t>(i * 3), 'x') + std::to_string(i));
+    }
+    EXPECT_TRUE(buffer.empty());
+    // Every element before a delimiter is examined once, however the input
+    // was segmented.
+    EXPECT_EQ(examined, data.size() - records.size());
+}
+
+TEST(ResumableScannerTest, budgeted_producer_yields) {
+    const std::string data = std::string(1000, 'p') + "\nq\n";
+    segment_producer  producer(data);
+
+    tb::resumable_scanner    scanner('\n');
+    std::string              buffer;
+    std::vector<std::string> records;
+    int                      yields = 0;
+    while (!producer.done() || !buffer.empty()) {
+        if (!producer.done()) {
+            buffer += producer.next();
+        }
+        const auto r = scanner.scan(buffer, 4);
+        if (r.status == tb::scan_status::budget_exhausted) {
+            ++yields;
+            continue;
+        }
+        if (r) {
+            records.emplace_back(buffer, 0, r.position);
+            buffer.erase(0, r.position + 1);
+            scanner.consume(r.position + 1);
+        } else if (producer.done()) {
+            break;
+        }
+    }
+    EXPECT_EQ(records, (std::vector<std::string>{std::string(1000, 'p'), "q"}));
+    EXPECT_GT(yields, 0);
+}
+
+TEST(ResumableScannerTest, wide_and_reset) {
+    std::wstring          buffer = L"one;two";
+    tb::resumable_scanner scanner(L';');
+    EXPECT_EQ(scanner.scan(buffer).position, 3u);
+
+    buffer = L"xy";
+    scanner.reset();
+    EXPECT_EQ(scanner.scan(buffer).status, tb::scan_status::need_more);
+    EXPECT_EQ(scanner.searched(), 2u);
+}
+
+TEST(ResumableScannerTest, constexpr_scan) {
+    constexpr auto position = [] {
+        tb::resumable_scanner scanner('|');
+        std::string_view      buffer = "ab";
+        (void)scanner.scan(buffer);
+        buffer = "ab|c";
+        return scanner.scan(buffer).position;
+    }();
+    static_assert(position == 2);
+}
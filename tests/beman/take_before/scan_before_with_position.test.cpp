@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/scan_before_with_position.hpp>
+
+#include <gtest/gtest.h>
+
+#include <concepts>
+#include <cstddef>
+#include <list>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tb = beman::take_before;
+
+namespace {
+
+struct position {
+    std::size_t end;
+    std::size_t lines;
+    std::size_t column;
+};
+
+position reference_scan(std::string_view s, char delimiter) {
+    position p{0, 0, 0};
+    for (; p.end < s.size() && s[p.end] != delimiter; ++p.end) {
+        if (s[p.end] == '\n') {
+            ++p.lines;
+            p.column = 0;
+        } else {
+            ++p.column;
+        }
+    }
+    return p;
+}
+
+} // namespace
+
+TEST(ScanBeforeWithPositionTest, counts_lines_and_column) {
+    const std::string s = "key = 1\nother = 2\n  bad $ here\n";
+    auto              r = tb::scan_before_with_position(s, '$');
+
+    EXPECT_EQ(r.end - s.begin(), 24);
+    EXPECT_EQ(r.lines_crossed, 2);
+    EXPECT_EQ(r.column, 6);
+}
+
+TEST(ScanBeforeWithPositionTest, no_newline_and_not_found) {
+    const std::string_view s = "abc;def";
+
+    auto r = tb::scan_before_with_position(s, ';');
+    EXPECT_EQ(r.lines_crossed, 0);
+    EXPECT_EQ(r.column, 3);
+
+    const std::string_view t = "a\nbc\n";
+    auto                   n = tb::scan_before_with_position(t, '#');
+    EXPECT_EQ(n.end, t.end());
+    EXPECT_EQ(n.lines_crossed, 2);
+    EXPECT_EQ(n.column, 0);
+}
+
+TEST(ScanBeforeWithPositionTest, newline_as_delimiter) {
+    auto r = tb::scan_before_with_position(std::string_view("first line\nsecond"), '\n');
+
+    EXPECT_EQ(r.lines_crossed, 0);
+    EXPECT_EQ(r.column, 10);
+}
+
+TEST(ScanBeforeWithPositionTest, word_kernel_agrees_with_scalar) {
+    // Newlines and delimiters at every offset relative to the eight-byte
+    // words, including several in one word and a delimiter in the same word
+    // as newlines on either side of it.
+    std::string text;
+    unsigned    seed = 7;
+    for (int k = 0; k < 3000; ++k) {
+        seed = seed * 1103515245 + 12345;
+        text.push_back("ab\n\n c;"[(seed >> 16) % 7]);
+    }
+    for (std::size_t at = 0; at < text.size(); at += 13) {
+        for (std::size_t len : {0u, 5u, 8u, 17u, 64u, 300u}) {
+            const std::string_view s = std::string_view(text).substr(at, len);
+            for (char d : {';', 'c', '\n', '#'}) {
+                const auto expected = reference_scan(s, d);
+                const auto r        = tb::scan_before_with_position(s, d);
+                EXPECT_EQ(static_cast<std::size_t>(r.end - s.begin()), expected.end);
+                EXPECT_EQ(static_cast<std::size_t>(r.lines_crossed), expected.lines);
+                EXPECT_EQ(static_cast<std::size_t>(r.column), expected.column);
+
+                const std::list<char> l(s.begin(), s.end());
+                const auto            lr = tb::scan_before_with_position(l, d);
+                EXPECT_EQ(static_cast<std::size_t>(lr.lines_crossed), expected.lines);
+                EXPECT_EQ(static_cast<std::size_t>(lr.column), expected.column);
+            }
+        }
+    }
+}
+
+TEST(ScanBeforeWithPositionTest, unrepresentable_delimiter_and_unbounded) {
+    // -1 never equals an unsigned char.
+    const std::vector<unsigned char> bytes = {'a', '\n', 0xFF, 'b'};
+    auto                             r     = tb::scan_before_with_position(bytes, -1);
+
+    EXPECT_EQ(r.end, bytes.end());
+    EXPECT_EQ(r.lines_crossed, 1);
+    EXPECT_EQ(r.column, 2);
+
+    const char* s = "x\ny\nzz\0";
+    auto        u = tb::scan_before_with_position(s, '\0');
+    EXPECT_EQ(u.end - s, 6);
+    EXPECT_EQ(u.lines_crossed, 2);
+    EXPECT_EQ(u.column, 2);
+}
+
+TEST(ScanBeforeWithPositionTest, temporary_string) {
+    auto r = tb::scan_before_with_position(std::string("a\nb$"), '$');
+    static_assert(std::same_as<decltype(r.end), std::ranges::dangling>);
+    EXPECT_EQ(r.lines_crossed, 1);
+    EXPECT_EQ(r.column, 1);
+}
+
+TEST(ScanBeforeWithPositionTest, constant_evaluation) {
+    constexpr auto r = tb::scan_before_with_position(std::string_view("a\nbb\nccc!"), '!');
+    static_assert(r.lines_crossed == 2 && r.column == 3);
+}
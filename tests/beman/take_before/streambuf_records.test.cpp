@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/streambuf_records.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tb = beman::take_before;
+
+namespace {
+
+// Serves a string through a get area of at most chunk characters, so that
+// records straddle refills.
+class chunked_buf : public std::streambuf {
+    std::string data_;
+    std::size_t chunk_;
+    std::size_t pos_ = 0;
+
+  public:
+    chunked_buf(std::string data, std::size_t chunk) : data_(std::move(data)), chunk_(chunk) {}
+
+    const char* storage() const { return data_.data(); }
+
+  protected:
+    int_type underflow() override {
+        if (pos_ == data_.size()) {
+            return traits_type::eof();
+        }
+        const std::size_t n = std::min(chunk_, data_.size() - pos_);
+        char*             p = data_.data() + pos_;
+        setg(p, p, p + n);
+        pos_ += n;
+        return traits_type::to_int_type(*p);
+    }
+};
+
+// No get area at all: every character goes through underflow and uflow.
+class unbuffered_buf : public std::streambuf {
+    std::string data_;
+    std::size_t pos_ = 0;
+
+  public:
+    explicit unbuffered_buf(std::string data) : data_(std::move(data)) {}
+
+  protected:
+    int_type underflow() override {
+        return pos_ == data_.size() ? traits_type::eof() : traits_type::to_int_type(data_[pos_]);
+    }
+    int_type uflow() override {
+        return pos_ == data_.size() ? traits_type::eof() : traits_type::to_int_type(data_[pos_++]);
+    }
+};
+
+std::vector<std::string> collect(std::streambuf& buf, char delimiter) {
+    std::vector<std::string> out;
+    for (std::string_view record : tb::streambuf_records(buf, delimiter)) {
+        out.emplace_back(record);
+    }
+    return out;
+}
+
+// What a std::getline loop reads.
+std::vector<std::string> reference(const std::string& data, char delimiter) {
+    std::istringstream       in(data);
+    std::vector<std::string> out;
+    for (std::string line; std::getline(in, line, delimiter);) {
+        out.push_back(line);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(StreambufRecordsTest, records_from_stringbuf) {
+    std::istringstream in("alpha\nbeta\n\ngamma");
+
+    EXPECT_EQ(collect(*in.rdbuf(), '\n'), (std::vector<std::string>{"alpha", "beta", "", "gamma"}));
+}
+
+TEST(StreambufRecordsTest, matches_getline_across_refills) {
+    const std::vector<std::string> inputs = {
+        "", "\n", "a", "a\n", "\n\nabc\n", "one,two,,three,", "x,yy,zzz,wwww,vvvvv",
+    };
+    for (const auto& data : inputs) {
+        const char delimiter = data.find(',') != std::string::npos ? ',' : '\n';
+        for (std::size_t chunk : {1u, 2u, 3u, 64u}) {
+            chunked_buf buf(data, chunk);
+            EXPECT_EQ(collect(buf, delimiter), reference(data, delimiter)) << data << ' ' << chunk;
+        }
+        unbuffered_buf buf(data);
+        EXPECT_EQ(collect(buf, delimiter), reference(data, delimiter)) << data;
+    }
+}
+
+TEST(StreambufRecordsTest, records_within_the_get_area_point_into_it) {
+    chunked_buf buf("key=value;k2=v2;", 100);
+
+    tb::streambuf_records records(buf, ';');
+    auto                  it = records.begin();
+    ASSERT_NE(it, records.end());
+    EXPECT_EQ(*it, "key=value");
+    EXPECT_EQ((*it).data(), buf.storage());
+    ++it;
+    EXPECT_EQ(*it, "k2=v2");
+    EXPECT_EQ((*it).data(), buf.storage() + 10);
+    ++it;
+    EXPECT_EQ(it, records.end());
+}
+
+TEST(StreambufRecordsTest, leaves_the_rest_of_the_stream_readable) {
+    std::istringstream in("header;rest of the stream");
+
+    tb::streambuf_records records(*in.rdbuf(), ';');
+    auto                  it = records.begin();
+    EXPECT_EQ(*it, "header");
+
+    std::string rest;
+    std::getline(in, rest);
+    EXPECT_EQ(rest, "rest of the stream");
+}
+
+TEST(StreambufRecordsTest, wide_and_view_concepts) {
+    std::wistringstream       in(L"x y z");
+    std::vector<std::wstring> out;
+    for (auto record : tb::wstreambuf_records(*in.rdbuf(), L' ')) {
+        out.emplace_back(record);
+    }
+    EXPECT_EQ(out, (std::vector<std::wstring>{L"x", L"y", L"z"}));
+
+    static_assert(std::ranges::input_range<tb::streambuf_records>);
+    static_assert(std::ranges::view<tb::streambuf_records>);
+    static_assert(!std::ranges::forward_range<tb::streambuf_records>);
+}
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/string_table.hpp>
+
+#include <gtest/gtest.h>
+
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tb = beman::take_before;
+
+using namespace std::string_view_literals;
+
+namespace {
+
+template <class R>
+std::vector<std::string> collect(R&& r) {
+    std::vector<std::string> result;
+    for (auto s : r) {
+        result.emplace_back(s);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(StringTableTest, concepts) {
+    static_assert(std::ranges::forward_range<tb::string_table_view>);
+    static_assert(std::ranges::common_range<tb::string_table_view>);
+    static_assert(std::ranges::view<tb::string_table_view>);
+    static_assert(std::ranges::borrowed_range<tb::string_table_view>);
+    static_assert(std::same_as<std::ranges::range_value_t<tb::string_table_view>, std::string_view>);
+}
+
+TEST(StringTableTest, proc_cmdline) {
+    constexpr auto cmdline = "/usr/bin/ls\0-l\0--color=auto\0"sv;
+
+    const std::vector<std::string> expected = {"/usr/bin/ls", "-l", "--color=auto"};
+    EXPECT_EQ(collect(tb::string_table_view(cmdline)), expected);
+}
+
+TEST(StringTableTest, elf_strtab_leading_empty_string) {
+    // An ELF string table starts with a NUL so that offset 0 names "".
+    constexpr auto strtab = "\0main\0_start\0"sv;
+
+    const std::vector<std::string> expected = {"", "main", "_start"};
+    EXPECT_EQ(collect(tb::string_table_view(strtab)), expected);
+}
+
+TEST(StringTableTest, consecutive_terminators) {
+    constexpr auto table = "a\0\0b\0"sv;
+
+    const std::vector<std::string> expected = {"a", "", "b"};
+    EXPECT_EQ(collect(tb::string_table_view(table)), expected);
+}
+
+TEST(StringTableTest, final_string_without_terminator) {
+    constexpr auto table = "HOME=/root\0TERM=xterm"sv;
+
+    const std::vector<std::string> expected = {"HOME=/root", "TERM=xterm"};
+    EXPECT_EQ(collect(tb::string_table_view(table)), expected);
+}
+
+TEST(StringTableTest, empty_table) {
+    EXPECT_TRUE(tb::string_table_view(std::string_view()).empty());
+    EXPECT_EQ(std::ranges::distance(tb::string_table_view("\0"sv)), 1);
+}
+
+TEST(StringTableTest, custom_delimiter) {
+    const std::string lines = "first\nsecond\n\nfourth";
+
+    const std::vector<std::string> expected = {"first", "second", "", "fourth"};
+    EXPECT_EQ(collect(tb::views::string_table(lines, '\n')), expected);
+}
+
+TEST(StringTableTest, segments_borrow_from_table) {
+    const std::vector<char> buffer = {'x', '\0', 'y', 'z', '\0'};
+    auto                    view   = tb::views::string_table(buffer);
+
+    auto it = view.begin();
+    EXPECT_EQ((*it).data(), buffer.data());
+    ++it;
+    EXPECT_EQ((*it).data(), buffer.data() + 2);
+    EXPECT_EQ((*it).size(), 2u);
+}
+
+TEST(StringTableTest, wide_characters) {
+    constexpr auto table = L"alpha\0beta\0"sv;
+
+    std::vector<std::wstring> result;
+    for (auto s : tb::wstring_table_view(table)) {
+        result.emplace_back(s);
+    }
+
+    const std::vector<std::wstring> expected = {L"alpha", L"beta"};
+    EXPECT_EQ(result, expected);
+}
+
+TEST(StringTableTest, constant_evaluation) {
+    constexpr auto count = [] { return std::ranges::distance(tb::string_table_view("a\0bc\0d"sv)); }();
+    static_assert(count == 3);
+
+    constexpr auto second = [] { return *std::ranges::next(tb::string_table_view("a\0bc\0d"sv).begin()); }();
+    static_assert(second == "bc");
+}
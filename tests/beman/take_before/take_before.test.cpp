@@ -1,14 +1,21 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
+#include <beman/take_before/copy_before.hpp>
 #include <beman/take_before/take_before.hpp>
 
 #include <gtest/gtest.h>
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
+#include <deque>
+#include <list>
 #include <ranges>
-#include <vector>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace tb = beman::take_before;
 
@@ -884,3 +891,271 @@ TEST(TakeBeforeTest, consecutive_delimiters) {
     std::vector<int> expected = {1}; // Stops at first 5
     EXPECT_EQ(result, expected);
 }
+
+// --- Eager span / string_view results for contiguous ranges ---
+
+TEST(TakeBeforeTest, take_before_sv_from_string_view) {
+    std::string_view s  = "key=value";
+    auto             sv = tb::take_before_sv(s, '=');
+
+    static_assert(std::same_as<decltype(sv), std::string_view>);
+    EXPECT_EQ(sv, "key");
+    EXPECT_EQ(sv.data(), s.data());
+}
+
+TEST(TakeBeforeTest, take_before_sv_from_pointer) {
+    const char* s = "One?Two";
+
+    EXPECT_EQ(tb::take_before_sv(s, '?'), "One");
+    EXPECT_EQ(tb::take_before_sv(s, '\0'), "One?Two");
+}
+
+TEST(TakeBeforeTest, take_before_sv_not_found) {
+    const std::string s = "no delimiter";
+
+    EXPECT_EQ(tb::take_before_sv(s, ';'), s);
+}
+
+TEST(TakeBeforeTest, take_before_sv_wide) {
+    std::wstring_view s = L"wide:string";
+
+    EXPECT_EQ(tb::take_before_sv(s, L':'), L"wide");
+}
+
+TEST(TakeBeforeTest, take_before_span_of_ints) {
+    std::vector<int> v = {1, 2, 3, 4};
+    auto             s = tb::take_before_span(v, 3);
+
+    static_assert(std::same_as<decltype(s), std::span<int>>);
+    ASSERT_EQ(s.size(), 2u);
+    EXPECT_EQ(s.data(), v.data());
+}
+
+TEST(TakeBeforeTest, take_before_span_integer_delimiter_for_bytes) {
+    const std::vector<unsigned char> v = {0x10, 0x20, 0xff, 0x30};
+
+    EXPECT_EQ(tb::take_before_span(v, 0xff).size(), 2u);
+    EXPECT_EQ(tb::take_before_span(v, -1).size(), 4u); // -1 never equals an unsigned char
+}
+
+TEST(TakeBeforeTest, view_to_span) {
+    std::string s = "path/to/file";
+    auto        b = s | tb::views::take_before('/');
+
+    auto span = b.to_span();
+    static_assert(std::same_as<decltype(span), std::span<char>>);
+    EXPECT_EQ(std::string_view(span.data(), span.size()), "path");
+
+    const auto& cb = b;
+    EXPECT_EQ(cb.to_span().size(), 4u);
+}
+
+TEST(TakeBeforeTest, view_to_span_unbounded) {
+    const char* s = "abc\0def";
+    auto        b = tb::views::take_before(s, '\0');
+
+    EXPECT_EQ(b.to_span().size(), 3u);
+}
+
+TEST(TakeBeforeTest, take_before_sv_constant_evaluation) {
+    static_assert(tb::take_before_sv(std::string_view("abc:def"), ':') == "abc");
+    static_assert(tb::take_before_sv("abc:def", ':') == "abc");
+}
+
+// --- reserve_hint ---
+
+TEST(TakeBeforeTest, reserve_hint_from_sized_base) {
+    std::vector<int> v = {1, 2, 3, 4, 5};
+    auto             b = v | tb::views::take_before(3);
+
+    EXPECT_EQ(b.reserve_hint(), 5u);
+    EXPECT_EQ(std::as_const(b).reserve_hint(), 5u);
+}
+
+TEST(TakeBeforeTest, reserve_hint_from_deque) {
+    std::deque<int> d(100, 7);
+    auto            b = d | tb::views::take_before(0);
+
+    EXPECT_EQ(b.reserve_hint(), 100u);
+}
+
+template <class V>
+concept has_reserve_hint = requires(V& v) { v.reserve_hint(); };
+
+TEST(TakeBeforeTest, no_reserve_hint_for_unbounded_base) {
+    static_assert(!has_reserve_hint<decltype(tb::views::take_before(std::declval<const char*>(), '\0'))>);
+    static_assert(has_reserve_hint<tb::take_before_view<std::ranges::ref_view<std::string>, char>>);
+}
+
+// --- ascii_icase / traits_char ---
+
+TEST(TakeBeforeTest, ascii_icase_letter) {
+    const std::string s = "content-type: text/plain; Boundary=xyz";
+
+    auto v = s | tb::views::take_before('b', tb::ascii_icase);
+    EXPECT_EQ(std::string(v.begin(), std::ranges::next(v.begin(), v.end())), "content-type: text/plain; ");
+    EXPECT_EQ(v.to_span().size(), 26u);
+    EXPECT_EQ(tb::take_before_sv(s, tb::ascii_icase_char('B')), "content-type: text/plain; ");
+    EXPECT_EQ(tb::take_before_sv(s, tb::ascii_icase_char('T')), "con");
+}
+
+TEST(TakeBeforeTest, ascii_icase_non_letter_matches_only_itself) {
+    // '@' | 0x20 == '`' and '[' | 0x20 == '{': only letters have another case.
+    const std::string_view s = "a`b{c@d[e";
+
+    EXPECT_EQ(tb::take_before_sv(s, tb::ascii_icase_char('@')), "a`b{c");
+    EXPECT_EQ(tb::take_before_sv(s, tb::ascii_icase_char('[')), "a`b{c@d");
+    EXPECT_EQ(tb::take_before_sv(s, tb::ascii_icase_char('`')), "a");
+}
+
+TEST(TakeBeforeTest, ascii_icase_kernel_agrees_with_scalar) {
+    // Every byte value at every offset of a buffer longer than a word, for a
+    // few delimiters, against the scalar loop over a non-contiguous range.
+    std::vector<char> bytes(300);
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<char>((i * 7) % 256);
+    }
+    const std::deque<char> d(bytes.begin(), bytes.end());
+    for (char c : {'q', 'Q', 'z', 'A', '@', '\xC1', '\xE1', '\0'}) {
+        for (std::size_t at = 0; at < 40; ++at) {
+            const std::string_view s(bytes.data() + at, bytes.size() - at);
+            const auto             tail = std::ranges::subrange(d.begin() + static_cast<std::ptrdiff_t>(at), d.end());
+            auto                   dv   = tail | tb::views::take_before(c, tb::ascii_icase);
+            const auto             n    = std::ranges::distance(dv.begin(), std::ranges::next(dv.begin(), dv.end()));
+            EXPECT_EQ(tb::take_before_sv(s, tb::ascii_icase_char(c)).size(), static_cast<std::size_t>(n))
+                << int(c) << ' ' << at;
+        }
+    }
+}
+
+TEST(TakeBeforeTest, ascii_icase_iterator_and_constant_evaluation) {
+    const char* s = "Host: example";
+    auto        v = tb::views::take_before(s, 'h', tb::ascii_icase);
+
+    EXPECT_EQ(v.to_span().size(), 0u);
+    EXPECT_EQ(tb::views::take_before(s + 1, 'E', tb::ascii_icase).to_span().size(), 5u);
+    static_assert(tb::take_before_sv(std::string_view("key=Value"), tb::ascii_icase_char('v')) == "key=");
+}
+
+namespace {
+
+// Compares case-insensitively, with its own find, as in [char.traits.require].
+struct ci_traits : std::char_traits<char> {
+    static constexpr char lower(char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c + 32) : c; }
+    static constexpr bool eq(char a, char b) { return lower(a) == lower(b); }
+    static constexpr const char* find(const char* p, std::size_t n, char c) {
+        for (; n != 0; --n, ++p) {
+            if (eq(*p, c)) {
+                return p;
+            }
+        }
+        return nullptr;
+    }
+};
+
+} // namespace
+
+TEST(TakeBeforeTest, custom_traits_string_view_base) {
+    const std::basic_string_view<char, ci_traits> s("Set-Cookie: X");
+
+    auto v = s | tb::views::take_before('c');
+    using ci_string_view = std::basic_string_view<char, ci_traits>;
+    static_assert(std::same_as<decltype(v), tb::take_before_view<ci_string_view, tb::traits_char<char, ci_traits>>>);
+    EXPECT_EQ(std::ranges::distance(v.begin(), std::ranges::next(v.begin(), v.end())), 4);
+    EXPECT_EQ(v.to_span().size(), 4u);
+    EXPECT_EQ(tb::views::take_before(s, 'x').to_span().size(), 12u);
+
+    // std::char_traits bases keep plain equality.
+    auto w = std::string_view("Set-Cookie") | tb::views::take_before('c');
+    static_assert(std::same_as<decltype(w), tb::take_before_view<std::string_view, char>>);
+    EXPECT_EQ(w.to_span().size(), 10u);
+}
+
+// --- code point delimiters ---
+
+TEST(TakeBeforeTest, code_point_on_utf8) {
+    const std::u8string s = u8"línea uno línea dos";
+
+    auto v = s | tb::views::take_before(U' ');
+    using V = tb::take_before_code_point_view<std::ranges::ref_view<const std::u8string>>;
+    static_assert(std::same_as<decltype(v), V>);
+    EXPECT_TRUE(std::u8string(v.begin(), std::ranges::next(v.begin(), v.end())) == u8"línea uno");
+    EXPECT_EQ(v.to_span().size(), 10u);
+    EXPECT_EQ(v.code_point(), U' ');
+
+    // U+00ED is C3 AD; U+00C3 is C3 83 and must not stop at the C3 of U+00ED.
+    EXPECT_EQ(tb::views::take_before(s, U'Ã').to_span().size(), s.size());
+    EXPECT_EQ(tb::views::take_before(s, U'í').to_span().size(), 1u);
+    EXPECT_EQ(tb::views::take_before(s, U' ').to_span().size(), 6u);
+}
+
+TEST(TakeBeforeTest, code_point_on_utf8_chars_and_non_contiguous) {
+    const std::string        s = "emoji \xF0\x9F\x98\x80 end";
+    const std::list<char8_t> l(s.begin(), s.end());
+
+    EXPECT_EQ(tb::views::take_before(s, U'\U0001F600').to_span().size(), 6u);
+    auto lv = l | tb::views::take_before(U'\U0001F600');
+    EXPECT_EQ(std::ranges::distance(lv.begin(), std::ranges::next(lv.begin(), lv.end())), 6);
+
+    // A truncated sequence at the end is not an occurrence.
+    const std::string_view cut = "ab\xF0\x9F\x98";
+    EXPECT_EQ(tb::views::take_before(cut, U'\U0001F600').to_span().size(), 5u);
+}
+
+TEST(TakeBeforeTest, code_point_on_utf16) {
+    const std::u16string s = u"a\U0001F600b c";
+
+    EXPECT_EQ(tb::views::take_before(s, U'\U0001F600').to_span().size(), 1u);
+    EXPECT_EQ(tb::views::take_before(s, U' ').to_span().size(), 4u);
+    EXPECT_EQ(tb::views::take_before(s, U'c').to_span().size(), 5u);
+    // A lone surrogate is not a code point and occurs nowhere.
+    EXPECT_EQ(tb::views::take_before(s, U'\xD83D').to_span().size(), s.size());
+}
+
+TEST(TakeBeforeTest, code_point_unbounded_and_constant_evaluation) {
+    const char8_t* s = u8"x y";
+    EXPECT_EQ(tb::views::take_before(s, U' ').to_span().size(), 1u);
+
+    constexpr auto n = [] {
+        auto v = std::u8string_view(u8"ab§cd") | tb::views::take_before(U'§');
+        return std::ranges::distance(v.begin(), std::ranges::next(v.begin(), v.end()));
+    }();
+    static_assert(n == 2);
+    static_assert(std::ranges::borrowed_range<decltype(std::u16string_view() | tb::views::take_before(U'x'))>);
+}
+
+namespace {
+
+// Every way of finding the end of a take_before view must agree with
+// iterating it, which compares `value == *it` after integer promotion.
+template <class E, class T>
+void expect_consistent_prefix(const std::vector<E>& data, const T& value, std::size_t expected) {
+    const auto view = tb::views::take_before(data, value);
+    EXPECT_EQ(static_cast<std::size_t>(std::ranges::distance(view)), expected);
+    EXPECT_EQ(view.to_span().size(), expected);
+    EXPECT_EQ(tb::take_before_span(data, value).size(), expected);
+
+    std::vector<E> out(data.size());
+    const auto     copied = tb::copy_before(data, value, out);
+    EXPECT_EQ(static_cast<std::size_t>(copied.out - out.begin()), expected);
+}
+
+} // namespace
+
+TEST(TakeBeforeTest, mixed_sign_delimiters_agree_with_iteration) {
+    // '\xff' is -1 as a char, and no unsigned char promotes to -1.
+    const std::vector<unsigned char> u = {1, 2, 0xff, 3};
+    expect_consistent_prefix(u, '\xff', 4);
+    expect_consistent_prefix(u, static_cast<unsigned char>(0xff), 2);
+
+    // 200 is no signed char, even though (signed char)200 is -56.
+    const std::vector<signed char> s = {1, static_cast<signed char>(200), 3};
+    expect_consistent_prefix(s, static_cast<unsigned char>(200), 3);
+    expect_consistent_prefix(s, static_cast<signed char>(-56), 1);
+
+    // Values that do survive the promotion are still found.
+    expect_consistent_prefix(u, static_cast<signed char>(2), 1);
+    expect_consistent_prefix(s, 3, 2);
+    const std::vector<char> c = {'a', 'b', ':', 'c'};
+    expect_consistent_prefix(c, static_cast<unsigned char>(':'), 2);
+}
@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/take_before_any_pattern.hpp>
+#include <beman/take_before/to.hpp>
+
+#include <gtest/gtest.h>
+
+#include <concepts>
+#include <list>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tb = beman::take_before;
+
+namespace {
+
+// Earliest start of any pattern, longest pattern on ties, by brute force.
+std::pair<std::size_t, std::size_t> reference_find(std::string_view text, const std::vector<std::string>& patterns) {
+    std::pair<std::size_t, std::size_t> best{text.size(), tb::pattern_set::npos};
+    for (std::size_t k = 0; k < patterns.size(); ++k) {
+        const std::size_t at = text.find(patterns[k]);
+        if (at == std::string_view::npos) {
+            continue;
+        }
+        if (at < best.first || (at == best.first && patterns[k].size() > patterns[best.second].size())) {
+            best = {at, k};
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+TEST(TakeBeforeAnyPatternTest, stops_at_earliest_pattern) {
+    const tb::pattern_set markers = {"\r\n", "\n\n", "<!--"};
+    const std::string     s       = "header text<!-- comment -->\r\nbody";
+
+    auto v = s | tb::views::take_before_any_pattern(markers);
+    EXPECT_EQ(tb::to<std::string>(v), "header text");
+
+    auto r = markers.find(s);
+    EXPECT_EQ(r.position - s.begin(), 11);
+    EXPECT_EQ(r.pattern, 2u);
+}
+
+TEST(TakeBeforeAnyPatternTest, later_ending_match_with_earlier_start) {
+    // "bcd" ends first, but "abcdef" starts earlier.
+    const tb::pattern_set set = {"bcd", "abcdef"};
+
+    EXPECT_EQ(tb::to<std::string>(std::string_view("xxabcdefyy") | tb::views::take_before_any_pattern(set)), "xx");
+    EXPECT_EQ(tb::to<std::string>(std::string_view("xxabcdeyy") | tb::views::take_before_any_pattern(set)), "xxa");
+}
+
+TEST(TakeBeforeAnyPatternTest, overlapping_and_nested_patterns) {
+    const std::vector<std::string> patterns = {"he", "she", "his", "hers", "s"};
+    const tb::pattern_set          set(patterns);
+
+    EXPECT_EQ(set.size(), 5u);
+    EXPECT_EQ(set[3], "hers");
+    for (std::string_view text : {"ushers", "ahishers", "xyz", "", "h", "she", "zzzzzzzzzzzzzzzzzhe"}) {
+        const auto expected = reference_find(text, patterns);
+        const auto r        = set.find(text);
+        EXPECT_EQ(static_cast<std::size_t>(r.position - text.begin()), expected.first) << text;
+        EXPECT_EQ(r.pattern, expected.second) << text;
+    }
+}
+
+TEST(TakeBeforeAnyPatternTest, agrees_with_brute_force) {
+    // Pseudo-random text over a small alphabet against pattern sets whose
+    // first bytes exercise each prefilter.
+    const std::vector<std::vector<std::string>> sets = {
+        {"abc"},
+        {"ab", "ba"},
+        {"aab", "bcd", "cca", "dd"},
+        {"a", "bb", "ccc", "dddd", "eeeee", "abcde"},
+    };
+    unsigned seed = 12345;
+    for (const auto& patterns : sets) {
+        const tb::pattern_set set(patterns);
+        for (int round = 0; round < 200; ++round) {
+            std::string text;
+            const int   len = static_cast<int>((seed = seed * 1103515245 + 12345) >> 16) % 60;
+            for (int i = 0; i < len; ++i) {
+                text += "abcdexyz"[((seed = seed * 1103515245 + 12345) >> 16) % 8];
+            }
+            const auto expected = reference_find(text, patterns);
+
+            const auto r = set.find(text);
+            EXPECT_EQ(static_cast<std::size_t>(r.position - text.begin()), expected.first) << text;
+            EXPECT_EQ(r.pattern, expected.second) << text;
+
+            const std::list<char> l(text.begin(), text.end());
+            const auto            lr = set.find(l);
+            EXPECT_EQ(static_cast<std::size_t>(std::ranges::distance(l.begin(), lr.position)), expected.first);
+            EXPECT_EQ(lr.pattern, expected.second);
+        }
+    }
+}
+
+TEST(TakeBeforeAnyPatternTest, no_match_and_empty_pattern) {
+    const tb::pattern_set set = {"zz"};
+    const std::string     s   = "no markers";
+
+    auto v = s | tb::views::take_before_any_pattern(set);
+    EXPECT_EQ(std::ranges::distance(v), 10);
+    EXPECT_EQ(set.find(s).pattern, tb::pattern_set::npos);
+
+    const tb::pattern_set with_empty = {"x", ""};
+    EXPECT_EQ(with_empty.find(s).position, s.begin());
+    EXPECT_EQ(with_empty.find(s).pattern, 1u);
+
+    const tb::pattern_set none;
+    EXPECT_EQ(none.find(s).position, s.end());
+}
+
+TEST(TakeBeforeAnyPatternTest, shared_set_and_range_concepts) {
+    const tb::pattern_set set = {"--", "=="};
+
+    const std::vector<std::string> lines = {"a--b", "cc==d", "e"};
+    std::vector<std::string>       heads;
+    for (const auto& line : lines) {
+        auto v = line | tb::views::take_before_any_pattern(set);
+        EXPECT_EQ(&v.patterns(), &set);
+        heads.push_back(tb::to<std::string>(v));
+    }
+    EXPECT_EQ(heads, (std::vector<std::string>{"a", "cc", "e"}));
+
+    using V = decltype(std::string_view() | tb::views::take_before_any_pattern(set));
+    static_assert(std::ranges::contiguous_range<V>);
+    static_assert(std::ranges::common_range<V>);
+    static_assert(std::ranges::borrowed_range<V>);
+    static_assert(!std::ranges::range<const V>);
+}
+
+TEST(TakeBeforeAnyPatternTest, moves_do_not_carry_cached_end) {
+    // The owned string is short enough to live inside the view, so the
+    // cached end of the original points into the moved-from object.
+    const tb::pattern_set set = {";"};
+    auto                  v   = std::string("ab;cd") | tb::views::take_before_any_pattern(set);
+
+    EXPECT_EQ(std::ranges::distance(v), 2);
+    auto moved = std::move(v);
+    EXPECT_EQ(tb::to<std::string>(moved), "ab");
+    EXPECT_EQ(moved.end() - moved.begin(), 2);
+}
+
+TEST(TakeBeforeAnyPatternTest, unbounded_iterator) {
+    const tb::pattern_set set = {"\r\n"};
+    const char*           s   = "GET / HTTP/1.1\r\nHost: x\r\n";
+
+    EXPECT_EQ(tb::to<std::string>(tb::views::take_before_any_pattern(s, set)), "GET / HTTP/1.1");
+}
+
+TEST(TakeBeforeAnyPatternTest, temporary_and_inline_sets_are_owned) {
+    const std::string_view doc = "head\n\nbody<!-- c -->";
+
+    auto v = tb::views::take_before_any_pattern(doc, {"\r\n", "\n\n", "<!--"});
+    EXPECT_EQ(tb::to<std::string>(v), "head");
+    EXPECT_EQ(v.patterns().size(), 3u);
+
+    // Copies share the owned set; the original may go away first.
+    auto copy = v;
+    v         = decltype(v)();
+    EXPECT_EQ(tb::to<std::string>(copy), "head");
+
+    EXPECT_EQ(tb::to<std::string>(doc | tb::views::take_before_any_pattern({"<!--"})), "head\n\nbody");
+    EXPECT_EQ(tb::to<std::string>(tb::views::take_before_any_pattern(doc, tb::pattern_set{"dy"})), "head\n\nbo");
+    EXPECT_EQ(tb::to<std::string>(tb::views::take_before_any_pattern(doc.data(), {"\n"})), "head");
+
+    const std::u8string_view u8 = u8"ab|cd";
+    auto                     w  = tb::views::take_before_any_pattern(u8, tb::u8pattern_set{u8"|"});
+    EXPECT_TRUE(tb::to<std::u8string>(w) == u8"ab");
+
+    static_assert(std::ranges::borrowed_range<decltype(v)>);
+    static_assert(!std::ranges::range<const decltype(v)>);
+}
+
+TEST(TakeBeforeAnyPatternTest, find_in_temporary_range) {
+    const tb::pattern_set set = {"ab", "x"};
+    const auto            r   = set.find(std::string("yyab"));
+    static_assert(std::same_as<decltype(r.position), std::ranges::dangling>);
+    EXPECT_EQ(r.pattern, 0u);
+    EXPECT_EQ(set.find(std::string("none")).pattern, tb::pattern_set::npos);
+}
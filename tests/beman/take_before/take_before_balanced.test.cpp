@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/take_before_balanced.hpp>
+#include <beman/take_before/to.hpp>
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tb = beman::take_before;
+
+namespace {
+
+template <class R>
+std::string collect(R&& r) {
+    std::string out;
+    for (char c : r) {
+        out += c;
+    }
+    if constexpr (requires { r.to_span(); }) {
+        auto s = r.to_span();
+        EXPECT_EQ(std::string(s.begin(), s.end()), out);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(TakeBeforeBalancedTest, skips_nested_pairs) {
+    const std::string s = "a, f(b, g(c)), d) + e";
+
+    EXPECT_EQ(collect(s | tb::views::take_before_balanced('(', ')')), "a, f(b, g(c)), d");
+}
+
+TEST(TakeBeforeBalancedTest, unbalanced_input) {
+    EXPECT_EQ(collect(std::string_view("(never closed") | tb::views::take_before_balanced('(', ')')), "(never closed");
+    EXPECT_EQ(collect(std::string_view(")") | tb::views::take_before_balanced('(', ')')), "");
+    EXPECT_EQ(collect(std::string_view("") | tb::views::take_before_balanced('(', ')')), "");
+}
+
+TEST(TakeBeforeBalancedTest, long_input_crosses_words) {
+    // Brackets at every offset around the eight-byte loads, and long runs
+    // without any.
+    for (std::size_t at = 0; at < 40; at += 3) {
+        const std::string body = std::string(at, 'x') + "{" + std::string(at, 'y') + "{}}" + std::string(17, 'z');
+        const std::string s    = body + "}" + std::string(at, 'w') + "}";
+
+        EXPECT_EQ(collect(s | tb::views::take_before_balanced('{', '}')), body) << at;
+
+        const std::list<char> l(s.begin(), s.end());
+        EXPECT_EQ(collect(l | tb::views::take_before_balanced('{', '}')), body) << at;
+    }
+}
+
+TEST(TakeBeforeBalancedTest, iterator_reports_depth) {
+    const std::string s = "a[b[c]]]";
+    auto              v = s | tb::views::take_before_balanced('[', ']');
+
+    std::vector<std::size_t> depths;
+    for (auto it = v.begin(); it != v.end(); ++it) {
+        depths.push_back(it.depth());
+    }
+    EXPECT_EQ(depths, (std::vector<std::size_t>{0, 0, 1, 1, 2, 2, 1}));
+}
+
+TEST(TakeBeforeBalancedTest, ntbs_and_input_ranges) {
+    const char* text = "x(y)z) tail";
+    EXPECT_EQ(collect(tb::views::take_before_balanced(text, '(', ')')), "x(y)z");
+
+    std::istringstream in("<a<b>>> rest");
+    using stream_iterator = std::istreambuf_iterator<char>;
+    auto input            = std::ranges::subrange(stream_iterator(in), stream_iterator());
+    EXPECT_EQ(collect(input | tb::views::take_before_balanced('<', '>')), "<a<b>>");
+}
+
+TEST(TakeBeforeBalancedTest, range_concepts) {
+    using V = decltype(std::string_view() | tb::views::take_before_balanced('(', ')'));
+    static_assert(std::ranges::forward_range<V>);
+    static_assert(!std::ranges::bidirectional_range<V>);
+    static_assert(!std::ranges::common_range<V>);
+    SUCCEED();
+}
+
+TEST(TakeBeforeBalancedTest, non_character_elements) {
+    const std::vector<int> v = {5, -1, 6, -2, 7, -2, 8};
+
+    auto r = v | tb::views::take_before_balanced(-1, -2);
+    EXPECT_EQ(r.to_span().size(), 5u);
+    EXPECT_EQ(std::ranges::distance(r), 5);
+}
+
+TEST(TakeBeforeBalancedTest, materializes_through_to) {
+    const std::string s = "key = {a = {b}}} next";
+
+    EXPECT_EQ(tb::to<std::string>(s | tb::views::take_before_balanced('{', '}')), "key = {a = {b}}");
+}
+
+TEST(TakeBeforeBalancedTest, constant_evaluation) {
+    constexpr std::string_view s = "f(x)) + 1";
+
+    static_assert(std::ranges::distance(s | tb::views::take_before_balanced('(', ')')) == 4);
+    static_assert((s | tb::views::take_before_balanced('(', ')')).to_span().size() == 4);
+    SUCCEED();
+}
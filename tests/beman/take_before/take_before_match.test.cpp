@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/take_before_match.hpp>
+#include <beman/take_before/to.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <ranges>
+#include <regex>
+#include <string>
+#include <string_view>
+
+namespace tb = beman::take_before;
+
+namespace {
+
+template <tb::fixed_string P>
+std::string before(std::string_view s) {
+    return tb::to<std::string>(s | tb::views::take_before_match<P>);
+}
+
+// The prefix before the leftmost match per std::regex (ECMAScript).
+std::string reference_before(std::string_view s, const char* pattern) {
+    std::match_results<std::string_view::const_iterator> m;
+    if (!std::regex_search(s.begin(), s.end(), m, std::regex(pattern))) {
+        return std::string(s);
+    }
+    return std::string(s.substr(0, static_cast<std::size_t>(m.position(0))));
+}
+
+// A forward iterator over a string that counts its dereferences.
+class counting_iterator {
+    const char*  p_     = nullptr;
+    std::size_t* reads_ = nullptr;
+
+  public:
+    using value_type      = char;
+    using difference_type = std::ptrdiff_t;
+
+    counting_iterator() = default;
+    counting_iterator(const char* p, std::size_t* reads) : p_(p), reads_(reads) {}
+
+    char operator*() const {
+        ++*reads_;
+        return *p_;
+    }
+    counting_iterator& operator++() {
+        ++p_;
+        return *this;
+    }
+    counting_iterator operator++(int) {
+        auto tmp = *this;
+        ++p_;
+        return tmp;
+    }
+    friend bool operator==(const counting_iterator& x, const counting_iterator& y) { return x.p_ == y.p_; }
+};
+
+} // namespace
+
+TEST(TakeBeforeMatchTest, literal_and_alternation) {
+    EXPECT_EQ(before<"\r\n\r\n">("Host: a\r\nX: b\r\n\r\nbody"), "Host: a\r\nX: b");
+    EXPECT_EQ(before<"cat|dog">("hotdog and cat"), "hot");
+    EXPECT_EQ(before<"cat|dog">("no pets"), "no pets");
+    EXPECT_EQ(before<"abc">(""), "");
+}
+
+TEST(TakeBeforeMatchTest, classes_and_repetition) {
+    EXPECT_EQ(before<"\\d+-\\d+">("call 555-1234 now"), "call ");
+    EXPECT_EQ(before<"[A-Z][a-z]*:">("lowercase Header: value"), "lowercase ");
+    EXPECT_EQ(before<"[^a-z ]">("only letters then 9"), "only letters then ");
+    EXPECT_EQ(before<"\\s*;">("a  ;b"), "a");
+    EXPECT_EQ(before<"(ab)+c">("aababc"), "a");
+    EXPECT_EQ(before<"colou?r">("the color"), "the ");
+    EXPECT_EQ(before<"\\x41\\.">("xA.y"), "x");
+    EXPECT_EQ(before<"a.c">("a\ncabc"), "a\nc");
+}
+
+TEST(TakeBeforeMatchTest, leftmost_start_over_earlier_end) {
+    // A match that starts later may end first; the earlier start still wins.
+    EXPECT_EQ(before<"abcd|c">("xabcd"), "x");
+    EXPECT_EQ(before<"abcd|bc">("abcd"), "");
+    EXPECT_EQ(before<"abce|bc">("abcd"), "a");
+    EXPECT_EQ(before<"a*b">("caab"), "c");
+    EXPECT_EQ(before<"a+b|aac">("aaac"), "a");
+    EXPECT_EQ(before<"x(ab)*y|b">("xababz"), "xa");
+}
+
+TEST(TakeBeforeMatchTest, single_pass) {
+    // Each start would rescan the run of a's; the search reads each byte once.
+    const std::string s = std::string(4000, 'a') + "c";
+    std::size_t       reads = 0;
+    auto              v     = tb::take_before_match_view<std::ranges::subrange<counting_iterator>, "a*b|c">(
+        std::ranges::subrange(counting_iterator(s.data(), &reads), counting_iterator(s.data() + s.size(), &reads)));
+    EXPECT_EQ(std::ranges::distance(v.begin(), v.end()), 4000);
+    EXPECT_EQ(reads, s.size());
+}
+
+TEST(TakeBeforeMatchTest, empty_match_gives_empty_view) {
+    EXPECT_EQ(before<"x*">("abc"), "");
+    EXPECT_EQ(before<"">("abc"), "");
+    EXPECT_EQ(before<"a|">("bbb"), "");
+}
+
+TEST(TakeBeforeMatchTest, agrees_with_std_regex) {
+    // Pseudo-random text over a small alphabet, so that patterns match
+    // often and at every kind of position.
+    std::string text;
+    unsigned    seed = 2024;
+    for (int k = 0; k < 2000; ++k) {
+        seed = seed * 1103515245 + 12345;
+        text.push_back("abcd \n"[(seed >> 16) % 6]);
+    }
+    for (std::size_t at = 0; at < text.size(); at += 37) {
+        const std::string_view s = std::string_view(text).substr(at, 90);
+        EXPECT_EQ(before<"abc">(s), reference_before(s, "abc")) << s;
+        EXPECT_EQ(before<"a+b+c">(s), reference_before(s, "a+b+c")) << s;
+        EXPECT_EQ(before<"(ab|ba)d">(s), reference_before(s, "(ab|ba)d")) << s;
+        EXPECT_EQ(before<"[cd][cd]|ad">(s), reference_before(s, "[cd][cd]|ad")) << s;
+        EXPECT_EQ(before<"d.d">(s), reference_before(s, "d.d")) << s;
+        EXPECT_EQ(before<"\\s\\S\\S\\s">(s), reference_before(s, "\\s\\S\\S\\s")) << s;
+        EXPECT_EQ(before<"c(a|b)*d">(s), reference_before(s, "c(a|b)*d")) << s;
+    }
+}
+
+TEST(TakeBeforeMatchTest, constant_evaluation) {
+    constexpr auto f = [](std::string_view s) {
+        auto v = s | tb::views::take_before_match<"[0-9]+px">;
+        return static_cast<std::size_t>(std::ranges::distance(v.begin(), v.end()));
+    };
+    static_assert(f("width: 12px;") == 7);
+    static_assert(f("width: auto") == 11);
+}
+
+TEST(TakeBeforeMatchTest, non_contiguous_and_unbounded) {
+    const std::string     s = "key=value;;next";
+    const std::list<char> l(s.begin(), s.end());
+
+    EXPECT_EQ(tb::to<std::string>(tb::views::take_before_match<";+n">(l)), "key=value");
+    EXPECT_EQ(tb::to<std::string>(tb::views::take_before_match<"=v">(s.c_str())), "key");
+}
+
+TEST(TakeBeforeMatchTest, view_properties) {
+    using V = decltype(std::string_view() | tb::views::take_before_match<"a">);
+    static_assert(std::ranges::contiguous_range<V>);
+    static_assert(std::ranges::common_range<V>);
+    static_assert(std::ranges::borrowed_range<V>);
+    static_assert(V::pattern() == "a");
+
+    std::string s = "abc";
+    auto        v = tb::views::take_before_match<"c">(s);
+    static_assert(std::ranges::borrowed_range<decltype(v)>);
+    EXPECT_EQ(v.size(), 2u);
+}
@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/take_before_unescaped.hpp>
+#include <beman/take_before/to.hpp>
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tb = beman::take_before;
+
+namespace {
+
+// Collects the view through its iterators, and, for contiguous bases,
+// checks that to_span() agrees.
+template <class R>
+std::string collect(R&& r) {
+    std::string out;
+    for (char c : r) {
+        out += c;
+    }
+    if constexpr (requires { r.to_span(); }) {
+        auto s = r.to_span();
+        EXPECT_EQ(std::string(s.begin(), s.end()), out);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(TakeBeforeUnescapedTest, stops_at_unescaped_delimiter) {
+    const std::string s = R"(say \"hi\" now" rest)";
+
+    EXPECT_EQ(collect(s | tb::views::take_before_unescaped('"', '\\')), R"(say \"hi\" now)");
+}
+
+TEST(TakeBeforeUnescapedTest, escape_runs) {
+    // An even run of escapes escapes itself, an odd one the delimiter.
+    EXPECT_EQ(collect(std::string_view(R"(a\\"b)") | tb::views::take_before_unescaped('"', '\\')), R"(a\\)");
+    EXPECT_EQ(collect(std::string_view(R"(a\\\"b"c)") | tb::views::take_before_unescaped('"', '\\')), R"(a\\\"b)");
+    EXPECT_EQ(collect(std::string_view(R"(\"\\")") | tb::views::take_before_unescaped('"', '\\')), R"(\"\\)");
+    EXPECT_EQ(collect(std::string_view(R"("x)") | tb::views::take_before_unescaped('"', '\\')), "");
+}
+
+TEST(TakeBeforeUnescapedTest, no_unescaped_delimiter) {
+    const std::string s = R"(all \" escaped \")";
+
+    EXPECT_EQ(collect(s | tb::views::take_before_unescaped('"', '\\')), s);
+}
+
+TEST(TakeBeforeUnescapedTest, agrees_with_scalar_on_all_short_inputs) {
+    // Every string over {a, \, "} up to length 8, contiguous and not.
+    for (int len = 0; len <= 8; ++len) {
+        int total = 1;
+        for (int i = 0; i < len; ++i) {
+            total *= 3;
+        }
+        for (int code = 0; code < total; ++code) {
+            std::string s;
+            for (int i = 0, c = code; i < len; ++i, c /= 3) {
+                s += "a\\\""[c % 3];
+            }
+            std::string expected;
+            bool        escaped = false;
+            for (char c : s) {
+                if (!escaped && c == '"') {
+                    break;
+                }
+                escaped = !escaped && c == '\\';
+                expected += c;
+            }
+            const std::list<char> l(s.begin(), s.end());
+            EXPECT_EQ(collect(s | tb::views::take_before_unescaped('"', '\\')), expected) << s;
+            EXPECT_EQ(collect(l | tb::views::take_before_unescaped('"', '\\')), expected) << s;
+        }
+    }
+}
+
+TEST(TakeBeforeUnescapedTest, ntbs_and_input_ranges) {
+    const char* arg = "a\\ b c";
+    EXPECT_EQ(collect(tb::views::take_before_unescaped(arg, ' ', '\\')), "a\\ b");
+
+    std::istringstream in("x\\;y;z");
+    using stream_iterator = std::istreambuf_iterator<char>;
+    auto input            = std::ranges::subrange(stream_iterator(in), stream_iterator());
+    auto v                = input | tb::views::take_before_unescaped(';', '\\');
+    EXPECT_EQ(collect(v), "x\\;y");
+}
+
+TEST(TakeBeforeUnescapedTest, range_concepts) {
+    using V = decltype(std::string_view() | tb::views::take_before_unescaped('"', '\\'));
+    static_assert(std::ranges::forward_range<V>);
+    static_assert(!std::ranges::bidirectional_range<V>);
+    static_assert(!std::ranges::common_range<V>);
+
+    using L = decltype(std::list<int>() | tb::views::take_before_unescaped(0, 1));
+    static_assert(std::ranges::forward_range<L>);
+    SUCCEED();
+}
+
+TEST(TakeBeforeUnescapedTest, non_character_elements) {
+    const std::vector<int> v = {1, 9, 0, 2, 9, 9, 0, 3};
+
+    auto r = v | tb::views::take_before_unescaped(0, 9);
+    EXPECT_EQ(std::vector<int>(r.begin(), std::ranges::next(r.begin(), r.end())).size(), 6u);
+    EXPECT_EQ(r.to_span().size(), 6u);
+}
+
+TEST(TakeBeforeUnescapedTest, materializes_through_to) {
+    const std::string s = R"(key\=with\=equals=value)";
+
+    EXPECT_EQ(tb::to<std::string>(s | tb::views::take_before_unescaped('=', '\\')), R"(key\=with\=equals)");
+}
+
+TEST(TakeBeforeUnescapedTest, constant_evaluation) {
+    constexpr std::string_view s = R"(a\,b,c)";
+
+    static_assert(std::ranges::distance(s | tb::views::take_before_unescaped(',', '\\')) == 4);
+    static_assert((s | tb::views::take_before_unescaped(',', '\\')).to_span().size() == 4);
+    SUCCEED();
+}
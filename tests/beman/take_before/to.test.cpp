@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/to.hpp>
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <ranges>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace tb = beman::take_before;
+
+TEST(ToTest, string_from_string) {
+    const std::string s = "user:password";
+
+    EXPECT_EQ(tb::to<std::string>(s | tb::views::take_before(':')), "user");
+    EXPECT_EQ(s | tb::views::take_before(':') | tb::to<std::string>(), "user");
+}
+
+TEST(ToTest, string_from_ntbs_allocates_exactly) {
+    const char* s = "a fairly long field that does not fit the small string buffer;rest";
+
+    auto result = tb::views::take_before(s, ';') | tb::to<std::string>();
+    EXPECT_EQ(result, "a fairly long field that does not fit the small string buffer");
+    EXPECT_EQ(result.capacity(), result.size());
+}
+
+TEST(ToTest, vector_of_trivially_copyable) {
+    const std::vector<int> v = {1, 2, 3, 0, 4};
+
+    auto result = v | tb::views::take_before(0) | tb::to<std::vector<int>>();
+    EXPECT_EQ(result, (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(result.capacity(), result.size());
+}
+
+TEST(ToTest, vector_of_strings) {
+    const std::vector<std::string> v = {"a", "b", "--", "c"};
+
+    auto result = v | tb::views::take_before(std::string("--")) | tb::to<std::vector<std::string>>();
+    EXPECT_EQ(result, (std::vector<std::string>{"a", "b"}));
+}
+
+TEST(ToTest, segmented_base) {
+    std::deque<int> d = {4, 5, 6, 7};
+
+    auto result = d | tb::views::take_before(6) | tb::to<std::vector<int>>();
+    EXPECT_EQ(result, (std::vector<int>{4, 5}));
+    EXPECT_EQ(result.capacity(), result.size());
+}
+
+TEST(ToTest, list_base_into_set) {
+    std::list<int> l = {3, 1, 2, 9, 7};
+
+    auto result = l | tb::views::take_before(9) | tb::to<std::set<int>>();
+    EXPECT_EQ(result, (std::set<int>{1, 2, 3}));
+}
+
+TEST(ToTest, single_pass_base) {
+    std::istringstream in("10 20 30 -1 40");
+
+    auto result = std::views::istream<int>(in) | tb::views::take_before(-1) | tb::to<std::vector<int>>();
+    EXPECT_EQ(result, (std::vector<int>{10, 20, 30}));
+}
+
+TEST(ToTest, forwards_constructor_arguments) {
+    const std::string s = "abc.def";
+
+    auto result = tb::to<std::string>(s | tb::views::take_before('.'), std::allocator<char>());
+    EXPECT_EQ(result, "abc");
+
+    auto piped = s | tb::views::take_before('.') | tb::to<std::string>(std::allocator<char>());
+    EXPECT_EQ(piped, "abc");
+}
+
+TEST(ToTest, plain_ranges) {
+    const std::vector<int> v = {1, 2, 3};
+
+    EXPECT_EQ(v | std::views::reverse | tb::to<std::vector<int>>(), (std::vector<int>{3, 2, 1}));
+}
+
+TEST(ToTest, single_pass_sized_base_reserves_once) {
+    std::istringstream in("1 2 3 -1 5 6 7 8");
+
+    auto base   = std::views::counted(std::istream_iterator<int>(in), 8);
+    auto result = base | tb::views::take_before(-1) | tb::to<std::vector<int>>();
+    EXPECT_EQ(result, (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(result.capacity(), 8u); // the base's size, reserved up front
+}
+
+TEST(ToTest, mixed_sign_delimiters) {
+    // '\xff' is -1 as a char, and no unsigned char promotes to -1.
+    const std::vector<unsigned char> u = {1, 2, 0xff, 3};
+    EXPECT_EQ(tb::to<std::vector<unsigned char>>(tb::views::take_before(u, '\xff')), u);
+    EXPECT_EQ(tb::to<std::vector<unsigned char>>(tb::views::take_before(u, static_cast<unsigned char>(0xff))),
+              (std::vector<unsigned char>{1, 2}));
+
+    // 200 is no signed char, even though (signed char)200 is -56.
+    const std::vector<signed char> s = {1, static_cast<signed char>(200), 3};
+    EXPECT_EQ(tb::to<std::vector<signed char>>(tb::views::take_before(s, static_cast<unsigned char>(200))), s);
+    EXPECT_EQ(tb::to<std::vector<signed char>>(tb::views::take_before(s, static_cast<signed char>(-56))),
+              (std::vector<signed char>{1}));
+}
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/take_before/validate_utf8_before.hpp>
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tb = beman::take_before;
+
+namespace {
+
+// Runs the contiguous, NTBS and list paths over the same bytes and checks
+// that they agree before returning the contiguous result.
+tb::validate_utf8_before_result<std::ptrdiff_t> check_all(const std::string& s, char delimiter) {
+    const auto r = tb::validate_utf8_before(s, delimiter);
+
+    const std::list<char> l(s.begin(), s.end());
+    const auto            lr = tb::validate_utf8_before(l, delimiter);
+    EXPECT_EQ(lr.distance, r.distance) << s;
+    EXPECT_EQ(lr.found, r.found) << s;
+    EXPECT_EQ(lr.error, r.error) << s;
+
+    if (r.found && delimiter != '\0' && s.find('\0') == std::string::npos) {
+        const auto nr = tb::validate_utf8_before(s.c_str(), delimiter);
+        EXPECT_EQ(nr.distance, r.distance) << s;
+        EXPECT_EQ(nr.error, r.error) << s;
+        EXPECT_TRUE(nr.found);
+    }
+    return r;
+}
+
+} // namespace
+
+TEST(ValidateUtf8BeforeTest, ascii) {
+    const auto r = check_all("user=admin", '=');
+
+    EXPECT_EQ(r.distance, 4);
+    EXPECT_TRUE(r.found);
+    EXPECT_TRUE(r.valid());
+}
+
+TEST(ValidateUtf8BeforeTest, multibyte_sequences) {
+    // 2, 3 and 4 byte sequences, including the boundaries of each range.
+    const std::string s = "\xc2\x80-\xdf\xbf-\xe0\xa0\x80-\xed\x9f\xbf-\xee\x80\x80-\xf0\x90\x80\x80-\xf4\x8f\xbf\xbf";
+    const auto        r = check_all(s + "|rest", '|');
+
+    EXPECT_EQ(r.distance, static_cast<std::ptrdiff_t>(s.size()));
+    EXPECT_TRUE(r.found);
+    EXPECT_TRUE(r.valid());
+}
+
+TEST(ValidateUtf8BeforeTest, ill_formed_sequences) {
+    struct Case {
+        std::string    bytes;
+        std::ptrdiff_t error;
+    };
+    const std::vector<Case> cases = {
+        {"ab\x80", 2},               // stray continuation byte
+        {"a\xc0\xaf", 1},            // overlong lead
+        {"a\xe0\x80\xaf", 1},        // overlong three-byte form
+        {"a\xed\xa0\x80", 1},        // surrogate
+        {"a\xf4\x90\x80\x80", 1},    // past U+10FFFF
+        {"a\xf5\x80\x80\x80", 1},    // invalid lead
+        {"abc\xe2\x82", 3},          // truncated by the end
+        {"abc\xe2\x82z", 3},         // broken by an ASCII byte
+        {"\xc3\xa9\xc3\xa9\xff", 4}, // after valid sequences
+    };
+    for (const auto& c : cases) {
+        const auto r = check_all(c.bytes, '|');
+        EXPECT_EQ(r.error, c.error) << c.bytes;
+        EXPECT_FALSE(r.valid()) << c.bytes;
+        EXPECT_EQ(r.distance, static_cast<std::ptrdiff_t>(c.bytes.size())) << c.bytes;
+    }
+}
+
+TEST(ValidateUtf8BeforeTest, delimiter_inside_sequence) {
+    const auto r = check_all("ab\xe2\x82|\xac", '|');
+
+    EXPECT_EQ(r.distance, 4);
+    EXPECT_TRUE(r.found);
+    EXPECT_EQ(r.error, 2);
+}
+
+TEST(ValidateUtf8BeforeTest, error_then_delimiter_far_away) {
+    std::string s = "x\xff" + std::string(100, 'y') + ";tail\xff";
+    const auto  r = check_all(s, ';');
+
+    EXPECT_EQ(r.error, 1);
+    EXPECT_EQ(r.distance, 102);
+    EXPECT_TRUE(r.found);
+}
+
+TEST(ValidateUtf8BeforeTest, word_boundaries) {
+    // Place a sequence and then the delimiter at every offset around the
+    // eight-byte loads.
+    for (std::size_t at = 0; at < 24; ++at) {
+        const std::string prefix(at, 'a');
+        EXPECT_TRUE(check_all(prefix + "\xe2\x82\xac" + "bb;c", ';').valid()) << at;
+        EXPECT_EQ(check_all(prefix + "\xe2\x82\xac" + "bb;c", ';').distance, static_cast<std::ptrdiff_t>(at + 5));
+        EXPECT_EQ(check_all(prefix + ";" + "\xff", ';').distance, static_cast<std::ptrdiff_t>(at));
+        EXPECT_EQ(check_all(prefix + "\xff" + std::string(at, 'b') + ";", ';').error,
+                  static_cast<std::ptrdiff_t>(at));
+    }
+}
+
+TEST(ValidateUtf8BeforeTest, nul_terminated) {
+    const char* s = "gr\xc3\xbc\xc3\x9f";
+    const auto  r = tb::validate_utf8_before(s, '\0');
+
+    EXPECT_EQ(r.distance, 6);
+    EXPECT_TRUE(r.found);
+    EXPECT_TRUE(r.valid());
+}
+
+TEST(ValidateUtf8BeforeTest, char8_t_and_input_ranges) {
+    const std::u8string s = u8"café\n";
+    EXPECT_TRUE(tb::validate_utf8_before(s, u8'\n').valid());
+
+    std::istringstream in("ok\xfe\n");
+    auto               r = tb::validate_utf8_before(
+        std::ranges::subrange(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()), '\n');
+    EXPECT_EQ(r.distance, 3);
+    EXPECT_EQ(r.error, 2);
+    EXPECT_TRUE(r.found);
+}
+
+TEST(ValidateUtf8BeforeTest, constant_evaluation) {
+    constexpr std::string_view s = "\xc3\xa9t\xc3\xa9:\xff";
+
+    static_assert(tb::validate_utf8_before(s, ':').valid());
+    static_assert(tb::validate_utf8_before(s, ':').distance == 5);
+    static_assert(tb::validate_utf8_before(s, '!').error == 6);
+    SUCCEED();
+}